@@ -0,0 +1,152 @@
+Prime factorizer
+Reads decimal numbers below 65025 one per line and prints each
+followed by a colon and its prime factors in ascending order
+[-]+[>>>>[-]>[-]<<<[-]<[-]+[>>,>>>[-]<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+
+>>>>>>]<<<+>>[<<[-]>>[-]]<[-]<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]
+<----------<+>[<[-]>[-]]<<[->>+>+<<<]>>>[-<<<+>>>]<[<<<<<<<[-]<[-]>>>>>>
+>>[-]]<[->+>+<<]>>[-<<+>>]<[<<<<<<<[-]>>>>>>>[-]][-]+<<[>>[-]<<[-]]>[>[-
+]<[-]]>[<<<<<.------------------------------------------------>[->>>>>+<
+<<<<]>[->>>>>+<<<<<]>>>>[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<
+<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-
+]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>>>[-<<<+
+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<
+<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>
+[-<+>]<<[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+
+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>
+>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>
+>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>
+>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<
+<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>
+>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<
+<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<
+[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[
+<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>>>[-<<<+>>>]
+<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<
+<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+
+>]<<[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<
+<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[
+-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>>>[-<<<+>>>]<[-<<<<<<<+>>>>>
+>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+>>>>>>>>>>]<
+[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>>>>>+<]>[-<+>]<<[->>+>+<<<]>
+>>[-<<<+>>>]<[-<<<<<<<+>>>>>>>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>
+>>>[-<<<<<<<<<<+>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<+>>>>>>>[-]]<]<[-<<<<<+>>
+>>>>+<]>[-<+>]<<[-]>[-]<<<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>
+>]<[-<<<<<+>>>>>>+<<<<<<[->>>>>>>+>+<<<<<<<<]>>>>>>>>[-<<<<<<<<+>>>>>>>>
+]<[<[-]>[-]]<[<<<<<+>>>>>[-]]<]<<<<<<<[-]+>>>>>>[-]]<<<<<[-]<<]>[>>>>+++
++++++++++++++++++++++++++++++++++++++++++++++++++++++++.[-][-]++>[-]<<<[
+->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<<<<<<<
+[-]+>>>>>>>[-]]<<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<<+
+>>>>>>>>>>]<[<<<<<<<[-]+>>>>>>>[-]][-]<<<<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<
+<<<<<<]>>>>>>>>>>>>>[-<<<<<<<<<<<<<+>>>>>>>>>>>>>]<-<<+>>[<<[-]>>[-]]<[-
+]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>
+>>>>>>>]<<+>[<[-]>[-]]<<<[-]>[>[<<[-]+>>[-]]<[-]]>[-]<<[<<<<<<[-]>>>>>>[
+-]]<<<<<<[>>>[-]<<<<<<[->>>>>>+>>>+<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>
+>>>]<<[-]<<<<<<[->>>>>>+>>+<<<<<<<<]>>>>>>>>[-<<<<<<<<+>>>>>>>>]<<<<<[-]
+>[-]>>>[-]<<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>][-]<<<[->>>>
++>+<<<<<]>>>>>[-<<<<<+>>>>>]<[<[-]+>[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]
+<[<[-]+>[-]]<[>+<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]<[<[-]>[-]]<[
+<<<->>>[-]]<<<<->>->>+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<<<<<
+<<[->>>>>>+>>>+<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]<<<<<<<+>>>>>>>+
+<<<<<<<[->>>>>>>>+>+<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]<[<[-]>[-]]
+<[<<<<<<+>>>>>>[-]]<[-]]<[-]<<<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]<[<[-]+
+>[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]+>[-]]<]<<<<<<<[->>>>>>>+>>+<
+<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]
+<[-<<->>]<[-]+<[>[-]<[-]]>[->+>+<<]>>[-<<+>>]<[>++++++++++++++++++++++++
+++++++++.[-]<<<<<<<<<<[->>>>>>>>>>+>>>>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>[-<
+<<<<<<<<<<<<<+>>>>>>>>>>>>>>]<<<<[->>>+>[-]<[->>+>+<<<]>>>[-<<<+>>>]<---
+-------<+>[<[-]>[-]]<[<[-]<<+>>>[-]]<<<<][-]>[->+>>[-]<<[->>>+>+<<<<]>>>
+>[-<<<<+>>>>]<----------<+>[<[-]>[-]]<[<<[-]<<+>>>>[-]]<<<][-]<[->>>>>+>
++<<<<<<]>>>>>>[-<<<<<<+>>>>>>]<[<<<<<+++++++++++++++++++++++++++++++++++
++++++++++++++.------------------------------------------------>>>>[-]+>[
+-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<<
+++++++++++++++++++++++++++++++++++++++++++++++++.-----------------------
+------------------------->>>[-]]<[-]<+++++++++++++++++++++++++++++++++++
++++++++++++++.<<<[-]>>[-]>[-]<<<<<<<<<<<<<<<[-]>>>>[-<<<<+>>>>>>>>>>>>+<
+<<<<<<<]>>>>>>>>[-<<<<<<<<+>>>>>>>>]<<<<<<<<<<<[-]>>>>[-<<<<+>>>>>>>>>>>
++<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]>[-]<<<<<<<<<<<<<[->>>>>>>>>>>>>>>+>+<
+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>]<-<<
++>>[<<[-]>>[-]]<[-]<<<<<<<<<<<<<[->>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<]>>>>>
+>>>>>>>>>>[-<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>]<<+>[<[-]>[-]]<<<[-]>[>[<<[-
+]+>>[-]]<[-]]>[-]<<[<<<<<<<<<[-]>>>>>>>>>[-]]<[-]]+<[->>+>+<<<]>>>[-<<<+
+>>>]<[<[-]>[-]]<[>>+<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<
+<<<+>>>>>>>>>>]<[<[-]>[-]]<[<[-]<<<<<<<<[->>>>>>>>>>+>>+<<<<<<<<<<<<]>>>
+>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<<<<<<<<<<<<<<[->>>>>>>>>>>>>+>+<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>]<<[->[->+>+<<]
+>>[-<<+>>]<[<->[-]]<<]>[->+>+<<]>>[-<<+>>]<[<<<<[-]+>>>>[-]]<[-]<<[-]]<[
+>++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<<[->>>>>>>>>>>>>+>>+<<<
+<<<<<<<<<<<<]>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>]<<<<<<<<<<
+<<<<[->>>>>>>>>>>>>+>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<+>>>>
+>>>>>>>>>>]>>>>>>>[-]++++++++++>[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<
+<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>
+>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<[>+
+<<<<<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>>>>>>[-<<<<<<<<<<<<<+>
+>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<->>>>>>>>>>[-]]<<<<<<<<<<<->>>>>>>>>
+->>+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<[-]++++++++++<<+>>>>>+
+<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<[<[-]>[-]]<[<<<<+>>>>[
+-]]<[-]]<[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<
+<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>
+>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<]<<<<<<<<++++++++++>>>>>>>
+[-<<<<<<<->>>>>>>]>[-]<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<
+<<<<<+>>>>>>>>>>]<----------<+>[<[-]>[-]]<[<<<<<<<<[-]>>>>>>>>[-]]<<<[-<
+<<<<<<+>>>>>>>]>[-<<<<<<<+>>>>>>>]>[-]++++++++++>[-]<<<<<<<<<<[->>>>>>>>
+>>>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<
+<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>
+]<[<[-]+>[-]]<[>+<<<<<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>>>>>>
+[-<<<<<<<<<<<<<+>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<->>>>>>>>>>[-]]<<<<
+<<<<<<<->>>>>>>>>->>+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<[-]++
+++++++++<<+>>>>>+<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<[<[-]
+>[-]]<[<<<<+>>>>[-]]<[-]]<[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>>>
+>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>>>>+>
++<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<]<<<<<<<+
++++++++++>>>>>>[-<<<<<<->>>>>>]>[-]<<<<<<<[->>>>>>>>+>+<<<<<<<<<]>>>>>>>
+>>[-<<<<<<<<<+>>>>>>>>>]<----------<+>[<[-]>[-]]<[<<<<<<<[-]>>>>>>>[-]]<
+<<[-<<<<<<<+>>>>>>>]>[-<<<<<<<+>>>>>>>]>[-]++++++++++>[-]<<<<<<<<<<[->>>
+>>>>>>>>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>
+[-]]<<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>
+>>>>>]<[<[-]+>[-]]<[>+<<<<<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>
+>>>>>[-<<<<<<<<<<<<<+>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<->>>>>>>>>>[-]
+]<<<<<<<<<<<->>>>>>>>>->>+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<
+[-]++++++++++<<+>>>>>+<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<
+[<[-]>[-]]<[<<<<+>>>>[-]]<[-]]<[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<
+]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>
+>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<]<<<
+<<<++++++++++>>>>>[-<<<<<->>>>>]>[-]<<<<<<[->>>>>>>+>+<<<<<<<<]>>>>>>>>[
+-<<<<<<<<+>>>>>>>>]<----------<+>[<[-]>[-]]<[<<<<<<[-]>>>>>>[-]]<<<[-<<<
+<<<<+>>>>>>>]>[-<<<<<<<+>>>>>>>]>[-]++++++++++>[-]<<<<<<<<<<[->>>>>>>>>>
+>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<
+<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<
+[<[-]+>[-]]<[>+<<<<<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>>>>>>[-
+<<<<<<<<<<<<<+>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<->>>>>>>>>>[-]]<<<<<<
+<<<<<->>>>>>>>>->>+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<[-]++++
+++++++<<+>>>>>+<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<[<[-]>[
+-]]<[<<<<+>>>>[-]]<[-]]<[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>>>>>
+>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>>>>+>+<
+<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<]<<<<<+++++
++++++>>>>[-<<<<->>>>]>[-]<<<<<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>
+>]<----------<+>[<[-]>[-]]<[<<<<<[-]>>>>>[-]]<<<[-<<<<<<<+>>>>>>>]>[-<<<
+<<<<+>>>>>>>]>[-]++++++++++>[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>
+>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>>>>
++>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<[>+<<<<
+<<<<<<<[->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>>>>>>[-<<<<<<<<<<<<<+>>>>>
+>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<->>>>>>>>>>[-]]<<<<<<<<<<<->>>>>>>>>->>+
+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]>[-]]<[<<[-]++++++++++<<+>>>>>+<<<<
+<[->>>>>>+>+<<<<<<<]>>>>>>>[-<<<<<<<+>>>>>>>]<[<[-]>[-]]<[<<<<+>>>>[-]]<
+[-]]<[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<
+<+>>>>>>>>>>>>]<[<[-]+>[-]]<<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>
+>>>[-<<<<<<<<<<<+>>>>>>>>>>>]<[<[-]+>[-]]<]<<<<++++++++++>>>[-<<<->>>]>[
+-]<<<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]<----------<+>[<[-]>[-]]<[<
+<<<[-]>>>>[-]]<<<[-<<<<<<<+>>>>>>>]>[-<<<<<<<+>>>>>>>]<<[->>+>+<<<]>>>[-
+<<<+>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<++++++++++++++++++++++++++++
+++++++++++++++++++++.------------------------------------------------>>[
+-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<<
+++++++++++++++++++++++++++++++++++++++++++++++++.-----------------------
+------------------------->>>[-]]<<<<[->>>>+>+<<<<<]>>>>>[-<<<<<+>>>>>]<[
+<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<<<++++++++++++++++++++++++++++++++++++
+++++++++++++.------------------------------------------------>>>>[-]]<<<
+<<[->>>>>+>+<<<<<<]>>>>>>[-<<<<<<+>>>>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>
+]<[<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---------------
+--------------------------------->>>>>[-]]<[-]+[->+>+<<]>>[-<<+>>]<[<<<<
+<<++++++++++++++++++++++++++++++++++++++++++++++++.---------------------
+--------------------------->>>>>>[-]]<[-]<<<<<[-]>[-]>[-]>[-]>[-]<<<<<<<
+<<<<<<<<<[-]>>>>>>>>>[-]]<<<<<<<<<<+>>>>>>>>>[-]]<[-]<<<<<<<]<[-]>>[-]>[
+-]>[-]>[-]>[-]<<<<<<++++++++++.[-]<<<<[-]]<<]
@@ -0,0 +1,373 @@
+Towers of Hanoi for 20 disks
+Prints every move as disk K FROM TO with pegs A B C
+All disks start on peg A and end on peg C
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]+[<[-]+[->>>+>+<<<<]>>>>[-<<
+<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<
+]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++.+++++.++++++++++.--------.-------------------------------
+--------------------------------------------.+++++++++++++++++.---------
+--------.[-]<<<<<<<<<<<<<<<<<<<<<<<<<+++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++.-----------------------------------------
+------------------------>>>>>>>>>>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<<<<
+<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>
+>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>
+>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>
+>[<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>[-]]+++++++++++++
++++++++++++++++++++.[-]<<<<<<<<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++.------------------------------
+----------------------------------->>>>>>>>>>>>>>>>>>>>>>>>>++++++++++.[
+-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]
+>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[
+-]]<[[-]>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------.--------
+-------------------------------------------------------------------.++++
+++++++++++++++.------------------.[-]<<<<<<<<<<<<<<<<<<<<<<<<+++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++.-----------------
+------------------------------------------------>>>>>>>>>>>>>>>>>>>>>>>>
+[-]<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>
+>>>>>>>>>>>>>>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<<<<<<<->>>>>>>>>>
+>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<<<<<<<<<[-]++>>>>>>>>>>>>>>>>>>>>>>>>[-]]
+++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<<<<<<<<<<<<<++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++++++++++.------------------
+----------------------------------------------->>>>>>>>>>>>>>>>>>>>>>>>+
++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+[-]]<[[-]>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------.-------
+--------------------------------------------------------------------.+++
+++++++++++++++++.-------------------.[-]<<<<<<<<<<<<<<<<<<<<<<<+++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++.---------------
+-------------------------------------------------->>>>>>>>>>>>>>>>>>>>>>
+>[-]<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<
+<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>
+>>>>>>>>>>>>>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>
+>>>>>>>>>[<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>[-]]+++++++++
++++++++++++++++++++++++.[-]<<<<<<<<<<<<<<<<<<<<<<<++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++.----------------------------
+------------------------------------->>>>>>>>>>>>>>>>>>>>>>>++++++++++.[
+-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[
+->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++.+++++.++++++++++.--------.----------------------------
+-----------------------------------------------.++++++++++++++++++++.---
+-----------------.[-]<<<<<<<<<<<<<<<<<<<<<<+++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++.-----------------------------------
+------------------------------>>>>>>>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<
+<<<<<[->>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>
+>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>]<<+>[<[-]>
+[-]]<<<<<<<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<<<<<<
+<[-]++>>>>>>>>>>>>>>>>>>>>>>[-]]++++++++++++++++++++++++++++++++.[-]<<<<
+<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++.------------------------------------------------------------
+----->>>>>>>>>>>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<
+<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]
+]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>[-]]<[[-]>++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------
+.-----------------------------------------------------------------------
+----.+++++++++++++++++++++.---------------------.[-]<<<<<<<<<<<<<<<<<<<<
+<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.-----
+------------------------------------------------------------>>>>>>>>>>>>
+>>>>>>>>>[-]<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<
+<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>
+>>>>>>>>>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>
+>[<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>[-]]+++++++++++++++++++++
++++++++++++.[-]<<<<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++.------------------------------------------
+----------------------->>>>>>>>>>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>
+>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-
+]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.-
+-------.----------------------------------------------------------------
+-----------.++++++++++++++++++++++.----------------------.[-]<<<<<<<<<<<
+<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++.----------------------------------------------------------------->>>>
+>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<
+<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>
+>>>>>>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>>>>>[<
+<<<<<<<<<<<<<<<<<<<[-]++>>>>>>>>>>>>>>>>>>>>[-]]++++++++++++++++++++++++
+++++++++.[-]<<<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++.----------------------------------------------
+------------------->>>>>>>>>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<
+<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]
+]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+[-]]<[[-]>++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------.-------
+--------------------------------------------------------------------.+++
+++++++++++++++++++++.-----------------------.[-]<<<<<<<<<<<<<<<<<<<+++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.-----------
+------------------------------------------------------>>>>>>>>>>>>>>>>>>
+>[-]<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<]>>
+>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>]<--<+>[
+<[-]>[-]]<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<<<<[-]
+>>>>>>>>>>>>>>>>>>>[-]]++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<<
+<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.
+----------------------------------------------------------------->>>>>>>
+>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<
+<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++.+++++.++++++++++.--------.--------------------------------------------
+-------------------------------.++++++++++++++++++++++++.---------------
+---------.[-]<<<<<<<<<<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++.-----------------------------------------------
+------------------>>>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>
+>>>>>>+>+<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<
++>>>>>>>>>>>>>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>
+>>[<<<<<<<<<<<<<<<<<<[-]++>>>>>>>>>>>>>>>>>>[-]]++++++++++++++++++++++++
+++++++++.[-]<<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++.------------------------------------------------
+----------------->>>>>>>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]
+>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>
+[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++.+++++.++++++++++.--------.-------------------------------
+--------------------------------------------.+++++++++++++++++++++++++.-
+------------------------.[-]<<<<<<<<<<<<<<<<<+++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++.---------------------------------
+-------------------------------->>>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<<[->
+>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<
+<<<<<<<<+>>>>>>>>>>>>>>>>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<<<<<<<<<+>>>>>>>>
+>>>>>>>>>[<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>[-]]+++++++++++++++++++++
++++++++++++.[-]<<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++.----------------------------------------------
+------------------->>>>>>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<
+]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[
+->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++.+++++.++++++++++.--------.----------------------------------------
+-----------------------------------.+++++++++++++++++.-.----------------
+.[-]<<<<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++.----------------------------------------------------------
+------->>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>+>+<<<<<<<<
+<<<<<<<<<<]>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>]<<+
+>[<[-]>[-]]<<<<<<<<<<<<<<<<<->>>>>>>>>>>>>>>>[<<<<<<<<<<<<<<<<[-]++>>>>>
+>>>>>>>>>>>[-]]++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<<<<<+++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.-----------
+------------------------------------------------------>>>>>>>>>>>>>>>>++
+++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<
+[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>
+>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]
+>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++.+++++.++++++++++.--------.----------------
+-----------------------------------------------------------.++++++++++++
++++++..-----------------.[-]<<<<<<<<<<<<<<<+++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++.-----------------------------------
+------------------------------>>>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<<[->>>>>>>
+>>>>>>>>>+>+<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<+>>>>>
+>>>>>>>>>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>[<<<<<<<<<<
+<<<<<[-]>>>>>>>>>>>>>>>[-]]++++++++++++++++++++++++++++++++.[-]<<<<<<<<<
+<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.
+----------------------------------------------------------------->>>>>>>
+>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]
+>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++.+++++.++++++++++.--------.----------------
+-----------------------------------------------------------.++++++++++++
++++++.+.------------------.[-]<<<<<<<<<<<<<<++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++.----------------------------------
+------------------------------->>>>>>>>>>>>>>[-]<<<<<<<<<<<<<<[->>>>>>>>
+>>>>>>>+>+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<+>>>>>>>>>>
+>>>>>>]<<+>[<[-]>[-]]<<<<<<<<<<<<<<<->>>>>>>>>>>>>>[<<<<<<<<<<<<<<[-]++>
+>>>>>>>>>>>>>[-]]++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<<<+++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.-----------
+------------------------------------------------------>>>>>>>>>>>>>>++++
+++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+
+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++.+++++.++++++++++.--------.--------------------------------------
+-------------------------------------.+++++++++++++++++.++.-------------
+------.[-]<<<<<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++++++.-------------------------------------------------------
+---------->>>>>>>>>>>>>[-]<<<<<<<<<<<<<[->>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<
+<]>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>]<--<+>[<[-]>[-]]<<<<<
+<<<<<<<<<+>>>>>>>>>>>>>[<<<<<<<<<<<<<[-]>>>>>>>>>>>>>[-]]+++++++++++++++
++++++++++++++++++.[-]<<<<<<<<<<<<<++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++.--------------------------------------------
+--------------------->>>>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>
+>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>
+>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]
+<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]
+]<[[-]>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------.----------
+-----------------------------------------------------------------.++++++
++++++++++++.+++.--------------------.[-]<<<<<<<<<<<<++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++.--------------------------
+--------------------------------------->>>>>>>>>>>>[-]<<<<<<<<<<<<[->>>>
+>>>>>>>>>+>+<<<<<<<<<<<<<<]>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<+>>>>>>>>>>>>>>
+]<<+>[<[-]>[-]]<<<<<<<<<<<<<->>>>>>>>>>>>[<<<<<<<<<<<<[-]++>>>>>>>>>>>>[
+-]]++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<<+++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++.---------------------------
+-------------------------------------->>>>>>>>>>>>++++++++++.[-]<]<[-]]<
+<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]
++>>>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<
+[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>[-]]<[[-]>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++.+++++.++++++++++.--------.----
+-----------------------------------------------------------------------.
++++++++++++++++++.++++.---------------------.[-]<<<<<<<<<<<+++++++++++++
+++++++++++++++++++++++++++++++++++++++++++++++++++++.-------------------
+---------------------------------------------->>>>>>>>>>>[-]<<<<<<<<<<<[
+->>>>>>>>>>>>+>+<<<<<<<<<<<<<]>>>>>>>>>>>>>[-<<<<<<<<<<<<<+>>>>>>>>>>>>>
+]<--<+>[<[-]>[-]]<<<<<<<<<<<<+>>>>>>>>>>>[<<<<<<<<<<<[-]>>>>>>>>>>>[-]]+
++++++++++++++++++++++++++++++++.[-]<<<<<<<<<<<++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++.--------------------------------
+--------------------------------->>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>
+>+>+<<<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>
+>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>
+>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++
+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++.+++++.++++++++++.--------.--------------------
+-------------------------------------------------------.++++++++++++++++
++.+++++.----------------------.[-]<<<<<<<<<<++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++.----------------------------------
+------------------------------->>>>>>>>>>[-]<<<<<<<<<<[->>>>>>>>>>>+>+<<
+<<<<<<<<<<]>>>>>>>>>>>>[-<<<<<<<<<<<<+>>>>>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<
+<<<<->>>>>>>>>>[<<<<<<<<<<[-]++>>>>>>>>>>[-]]+++++++++++++++++++++++++++
++++++.[-]<<<<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++++++++++.-----------------------------------------------------------
+------>>>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>
+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<
+<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<
+<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+
+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>
+>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.+++++.++++++
+++++.--------.----------------------------------------------------------
+-----------------.+++++++++++++++++.++++++.-----------------------.[-]<<
+<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+.----------------------------------------------------------------->>>>>>
+>>>[-]<<<<<<<<<[->>>>>>>>>>+>+<<<<<<<<<<<]>>>>>>>>>>>[-<<<<<<<<<<<+>>>>>
+>>>>>>]<--<+>[<[-]>[-]]<<<<<<<<<<+>>>>>>>>>[<<<<<<<<<[-]>>>>>>>>>[-]]+++
++++++++++++++++++++++++++++++.[-]<<<<<<<<<++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++.------------------------------------
+----------------------------->>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<
+<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>
+>>>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>
+>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-
+]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-
+]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<
+<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.
++++++.++++++++++.--------.----------------------------------------------
+-----------------------------.+++++++++++++++++.+++++++.----------------
+--------.[-]<<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++.----------------------------------------------------------
+------->>>>>>>>[-]<<<<<<<<[->>>>>>>>>+>+<<<<<<<<<<]>>>>>>>>>>[-<<<<<<<<<
+<+>>>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<<<->>>>>>>>[<<<<<<<<[-]++>>>>>>>>[-]]+
++++++++++++++++++++++++++++++++.[-]<<<<<<<<+++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++++++++++.-----------------------------------
+------------------------------>>>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<
+<<]>>>>[-<<<<+>>>>]<[>>+<<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>
+>>>>>>>>>+>+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>>[
+-<<<<<<<<<<<<<<<<<<<<<<<<<<<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]
+<[<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]+>>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+
+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>
+>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]>+++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++.+++++.++++
+++++++.--------.--------------------------------------------------------
+-------------------.+++++++++++++++++.++++++++.-------------------------
+.[-]<<<<<<<+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+++++.----------------------------------------------------------------->>
+>>>>>[-]<<<<<<<[->>>>>>>>+>+<<<<<<<<<]>>>>>>>>>[-<<<<<<<<<+>>>>>>>>>]<--
+<+>[<[-]>[-]]<<<<<<<<+>>>>>>>[<<<<<<<[-]>>>>>>>[-]]+++++++++++++++++++++
++++++++++++.[-]<<<<<<<++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++.--------------------------------------------------------
+--------->>>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<[>
+>+<<<<<<<<<<<<<<<<<<<<<<<<<<[->>>>>>>>>>>>>>>>>>>>>>>>>>>+>+<<<<<<<<<<<<
+<<<<<<<<<<<<<<<<]>>>>>>>>>>>>>>>>>>>>>>>>>>>>[-<<<<<<<<<<<<<<<<<<<<<<<<<
+<<<+>>>>>>>>>>>>>>>>>>>>>>>>>>>>]<[<[-]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<
+[-]+>>>>>>>>>>>>>>>>>>>>>[-]>>>>[-]+>[-]]+<[->>+>+<<<]>>>[-<<<+>>>]<[<[-
+]>[-]]<[<<<<<<<<<<<<<<<<<<<<<<<<<<[-]>>>>>>>>>>>>>>>>>>>>>>>>>>[-]]<[[-]
+>+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++.+++++.++++++++++.--------.----------------
+-----------------------------------------------------------.++++++++++++
+++++++.--.----------------.[-]<<<<<<++++++++++++++++++++++++++++++++++++
++++++++++++++++++++++++++++++.------------------------------------------
+----------------------->>>>>>[-]<<<<<<[->>>>>>>+>+<<<<<<<<]>>>>>>>>[-<<<
+<<<<<+>>>>>>>>]<<+>[<[-]>[-]]<<<<<<<->>>>>>[<<<<<<[-]++>>>>>>[-]]+++++++
++++++++++++++++++++++++++.[-]<<<<<<+++++++++++++++++++++++++++++++++++++
+++++++++++++++++++++++++++++.-------------------------------------------
+---------------------->>>>>>++++++++++.[-]<]<[-]]<<<[->>>+>+<<<<]>>>>[-<
+<<<+>>>>]<[<<[-]>>[-]]<<<[-]>]
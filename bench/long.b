@@ -0,0 +1,23 @@
+Long loop stress test
+Four nested counted loops around a tight inner loop that no idiom
+matches; prints the two accumulator cells when done
+[-]++++++++[>[-]--------------------------------------------------------
+[>[-]------[>[-]--[>+>---<<--]<-]<-]<-]>>>>[->>+>>>>+<<<<<<]>>>>>>[-<<<<
+<<+>>>>>>]<<<<[->>>+>[-]<[->>+>+<<<]>>>[-<<<+>>>]<----------<+>[<[-]>[-]
+]<[<[-]<<+>>>[-]]<<<<][-]>[->+>>[-]<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<-----
+-----<+>[<[-]>[-]]<[<<[-]<<+>>>>[-]]<<<][-]<[->>>>>+>+<<<<<<]>>>>>>[-<<<
+<<<+>>>>>>]<[<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.-----
+------------------------------------------->>>>[-]+>[-]]<<<[->>>+>+<<<<]
+>>>>[-<<<<+>>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<<+++++++++++++++++++
++++++++++++++++++++++++++++++.------------------------------------------
+------>>>[-]]<[-]<++++++++++++++++++++++++++++++++++++++++++++++++.<<<[-
+]>>[-]>[-]<<<++++++++++++++++++++++++++++++++.[-]<[->+>>>>+<<<<<]>>>>>[-
+<<<<<+>>>>>]<<<<[->>>+>[-]<[->>+>+<<<]>>>[-<<<+>>>]<----------<+>[<[-]>[
+-]]<[<[-]<<+>>>[-]]<<<<][-]>[->+>>[-]<<[->>>+>+<<<<]>>>>[-<<<<+>>>>]<---
+-------<+>[<[-]>[-]]<[<<[-]<<+>>>>[-]]<<<][-]<[->>>>>+>+<<<<<<]>>>>>>[-<
+<<<<<+>>>>>>]<[<<<<<++++++++++++++++++++++++++++++++++++++++++++++++.---
+--------------------------------------------->>>>[-]+>[-]]<<<[->>>+>+<<<
+<]>>>>[-<<<<+>>>>]<[<[-]+>[-]]<[->+>+<<]>>[-<<+>>]<[<<<+++++++++++++++++
++++++++++++++++++++++++++++++++.----------------------------------------
+-------->>>[-]]<[-]<++++++++++++++++++++++++++++++++++++++++++++++++.<<<
+[-]>>[-]>[-]<<<++++++++++.[-]
@@ -4,11 +4,7 @@
 HINSTANCE hInst;
 HFONT hMonoFont = NULL;
 HFONT hLabelFont = NULL;
-HWND hwndCodeEdit = NULL;
-HWND hwndInputEdit = NULL;
-HWND hwndOutputEdit = NULL;
-HANDLE g_hInterpreterThread = NULL;
-volatile BOOL g_bInterpreterRunning = FALSE;
+HWND hwndTabControl = NULL;
 HACCEL hAccelTable = NULL;
 
 // Global debug settings flags
@@ -16,6 +12,20 @@ volatile BOOL g_bDebugInterpreter = FALSE;
 volatile BOOL g_bDebugOutput = FALSE;
 volatile BOOL g_bDebugBasic = TRUE;
 
+// Global interpreter settings
+volatile int g_nEngine = ENGINE_THREADED;
+volatile BOOL g_bProfile = FALSE;
+volatile BOOL g_bLargeTape = FALSE;
+volatile int g_nCellWidth = CELL_8BIT;
+volatile DWORD g_dwStepLimit = 0;
+volatile DWORD g_dwTimeLimit = 0;
+volatile DWORD g_dwOutputLimit = 0;
+volatile BOOL g_bTrace = FALSE;
+volatile DWORD g_dwCheckpointInterval = 0;
+
+// Session shown in the main window; every other tab's controls are hidden
+Session* g_pActiveSession = NULL;
+
 // Helper to load strings from resource, ensures null termination
 char* LoadStringFromResource(UINT uID, char* buffer, int bufferSize) {
     if (LoadStringA(hInst, uID, buffer, bufferSize) > 0)
@@ -28,13 +38,6 @@ char* LoadStringFromResource(UINT uID, char* buffer, int bufferSize) {
 }
 
 
-// Helper function to append text to an EDIT control
-void AppendTextToEditControl(HWND hwndEdit, const char* newText) {
-    int len = GetWindowTextLengthA(hwndEdit);
-    SendMessageA(hwndEdit, EM_SETSEL, (WPARAM)len, (LPARAM)len);
-    SendMessageA(hwndEdit, EM_REPLACESEL, 0, (LPARAM)newText);
-}
-
 // Helper function for conditional debug output
 // WARNING: vsprintf is not bounds-checked. Use with extreme caution.
 // Ensure buffer is large enough for the expected output.
@@ -71,195 +74,588 @@ void DebugPrintOutput(const char* format, ...) {
     OutputDebugStringA(buffer);
 }
 
-// --- Brainfuck Tape Structure and Functions ---
-void Tape_init(Tape* tape) {
-    memset(tape->tape, 0, TAPE_SIZE);
-    tape->position = 0;
+// Appends text to an output view, which needs no \r\n conversion.
+void AppendOutputText(HWND hwndView, const char* text) {
+    SendMessageA(hwndView, OVM_APPEND, (WPARAM)strlen(text), (LPARAM)text);
+}
+
+// --- Output Ring ---
+// A single-producer, single-consumer byte queue. head and tail count bytes
+// written and read since the last reset and wrap modulo 2^32; the ring size
+// is a power of two, so head - tail is always the number of bytes queued.
+// Each side only writes its own index, and publishes it with an interlocked
+// exchange after touching the data, which orders the data access before it.
+BOOL InitOutputRing(OutputRing* ring) {
+    ring->data = (char*)malloc(OUTPUT_RING_SIZE);
+    ring->head = 0;
+    ring->tail = 0;
+    return ring->data != NULL;
+}
+
+// Called on the UI thread while no interpreter thread is running.
+void ResetOutputRing(OutputRing* ring) {
+    InterlockedExchange(&ring->head, 0);
+    InterlockedExchange(&ring->tail, 0);
 }
 
-unsigned char Tape_get(Tape* tape) {
-    return tape->tape[tape->position];
+// Copies up to length bytes in and returns how many fit.
+static size_t WriteOutputRing(OutputRing* ring, const char* data, size_t length) {
+    DWORD head = (DWORD)ring->head; // Only this thread writes head
+    DWORD tail = (DWORD)InterlockedExchangeAdd(&ring->tail, 0);
+    size_t space = OUTPUT_RING_SIZE - (size_t)(head - tail);
+    size_t start = head & (OUTPUT_RING_SIZE - 1);
+    size_t first;
+
+    if (length > space)
+        length = space;
+    first = OUTPUT_RING_SIZE - start < length ? OUTPUT_RING_SIZE - start : length;
+    memcpy(ring->data + start, data, first);
+    memcpy(ring->data, data + first, length - first);
+    InterlockedExchange(&ring->head, (LONG)(head + (DWORD)length));
+    return length;
 }
 
-void Tape_set(Tape* tape, unsigned char value) {
-    tape->tape[tape->position] = value;
+// Moves everything queued into the output view, which copies it, straight
+// from the ring's storage. Returns the number of bytes moved.
+static size_t ReadOutputRing(OutputRing* ring, HWND hwndView) {
+    DWORD tail = (DWORD)ring->tail; // Only this thread writes tail
+    DWORD head = (DWORD)InterlockedExchangeAdd(&ring->head, 0);
+    size_t length = (size_t)(head - tail);
+    size_t start = tail & (OUTPUT_RING_SIZE - 1);
+    size_t first;
+
+    if (length == 0)
+        return 0;
+    first = OUTPUT_RING_SIZE - start < length ? OUTPUT_RING_SIZE - start : length;
+    SendMessageA(hwndView, OVM_APPEND, (WPARAM)first, (LPARAM)(ring->data + start));
+    if (length > first)
+        SendMessageA(hwndView, OVM_APPEND, (WPARAM)(length - first), (LPARAM)ring->data);
+    InterlockedExchange(&ring->tail, (LONG)(tail + (DWORD)length));
+    return length;
 }
 
-void Tape_inc(Tape* tape) {
-    tape->tape[tape->position]++;
+// Moves queued output into the output view, a snapshot of the ring at a
+// time, until the ring is empty or budgetMs have passed; a budget of 0 takes
+// one snapshot. The interpreter thread keeps filling the ring meanwhile, so
+// output streams at the speed of the view while the UI thread still gets back
+// to its other messages however much the program prints.
+void DrainOutputRing(OutputRing* ring, HWND hwndView, DWORD budgetMs) {
+    DWORD start = GetTickCount();
+    while (ReadOutputRing(ring, hwndView) > 0 && GetTickCount() - start < budgetMs)
+        ;
 }
 
-void Tape_dec(Tape* tape) {
-    tape->tape[tape->position]--;
+// --- Program File ---
+BOOL OpenSourceFile(SourceFile* file, const char* path) {
+    DWORD sizeHigh = 0, sizeLow;
+    memset(file, 0, sizeof(*file));
+    file->hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file->hFile == INVALID_HANDLE_VALUE) {
+        DebugPrint("OpenSourceFile: CreateFileA failed with error %lu.\n", GetLastError());
+        file->hFile = NULL;
+        return FALSE;
+    }
+    sizeLow = GetFileSize(file->hFile, &sizeHigh);
+    // A file larger than the address space cannot be mapped whole.
+    if ((sizeLow == INVALID_FILE_SIZE && GetLastError() != NO_ERROR) || (sizeHigh != 0 && sizeof(size_t) < 8)) {
+        CloseSourceFile(file);
+        return FALSE;
+    }
+    file->length = (size_t)(((ULONGLONG)sizeHigh << 32) | sizeLow);
+    if (file->length == 0)
+        return TRUE;
+    file->hMapping = CreateFileMappingA(file->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (file->hMapping)
+        file->data = (const char*)MapViewOfFile(file->hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!file->data) {
+        DebugPrint("OpenSourceFile: Mapping failed with error %lu.\n", GetLastError());
+        CloseSourceFile(file);
+        return FALSE;
+    }
+    return TRUE;
 }
 
-void Tape_forward(Tape* tape) {
-    tape->position++;
-    if (tape->position >= TAPE_SIZE)
-        tape->position = 0;
+void CloseSourceFile(SourceFile* file) {
+    if (file->data)
+        UnmapViewOfFile((LPCVOID)file->data);
+    if (file->hMapping)
+        CloseHandle(file->hMapping);
+    if (file->hFile)
+        CloseHandle(file->hFile);
+    memset(file, 0, sizeof(*file));
 }
 
-void Tape_reverse(Tape* tape) {
-    tape->position--;
-    if (tape->position < 0)
-        tape->position = TAPE_SIZE - 1;
+// Makes path the program that File > Run compiles in the active session,
+// straight from a mapping of the file. The editor only gets the first
+// SOURCE_PREVIEW_SIZE bytes and is read-only until another file is opened or
+// File > New is chosen.
+BOOL BindProgramFile(HWND hwnd, const char* path) {
+    char strBuffer[MAX_STRING_LENGTH];
+    SourceFile source;
+    if (!OpenSourceFile(&source, path)) {
+        MessageBoxA(hwnd, LoadStringFromResource(IDS_SOURCE_FILE_ERROR, strBuffer, MAX_STRING_LENGTH), "File Error", MB_OK | MB_ICONERROR);
+        return FALSE;
+    }
+    size_t previewLength = source.length < SOURCE_PREVIEW_SIZE ? source.length : SOURCE_PREVIEW_SIZE;
+    char* preview = (char*)malloc(previewLength + 1);
+    if (preview) {
+        memcpy(preview, source.data, previewLength);
+        preview[previewLength] = '\0';
+        SetWindowTextA(g_pActiveSession->hwndCodeEdit, preview);
+        free(preview);
+    } else
+        SetWindowTextA(g_pActiveSession->hwndCodeEdit, "");
+    CloseSourceFile(&source);
+
+    strcpy(g_pActiveSession->szProgramFile, path);
+    UpdateProgramBinding(hwnd);
+    return TRUE;
 }
 
-// --- Interpreter Logic ---
-void SendBufferedOutput(InterpreterParams* params) {
-    if (params->output_buffer_pos > 0) {
-        params->output_buffer[params->output_buffer_pos] = '\0';
-        char* output_string = strdup(params->output_buffer); // Changed from _strdup
-        if (output_string)
-            PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, 0, (LPARAM)output_string);
-        else {
-            DebugPrint("SendBufferedOutput: Failed to duplicate output string.\n");
-            char errorBuffer[MAX_STRING_LENGTH];
-            LoadStringFromResource(IDS_MEM_ERROR_PARAMS, errorBuffer, MAX_STRING_LENGTH); 
-            PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, 0, (LPARAM)strdup(errorBuffer)); // Changed from _strdup
+// Reflects the active session's szProgramFile in the code label and the
+// editor's read-only state. An unbound session's label also shows the
+// problem its last analysis found, if any.
+void UpdateProgramBinding(HWND hwnd) {
+    char strBuffer[MAX_STRING_LENGTH];
+    char labelBuffer[MAX_STRING_LENGTH + MAX_PATH];
+    Session* session = g_pActiveSession;
+    BOOL bound = session->szProgramFile[0] != '\0';
+
+    SendMessageA(session->hwndCodeEdit, EM_SETREADONLY, (WPARAM)bound, 0);
+    if (bound) {
+        LoadStringFromResource(IDS_CODE_FILE_LABEL, strBuffer, MAX_STRING_LENGTH);
+        sprintf(labelBuffer, strBuffer, session->szProgramFile);
+    } else if (session->szCodeError[0] != '\0')
+        strcpy(labelBuffer, session->szCodeError);
+    else
+        LoadStringFromResource(IDS_CODE_LABEL, labelBuffer, MAX_STRING_LENGTH);
+    SetDlgItemTextA(hwnd, IDC_STATIC_CODE, labelBuffer);
+}
+
+// --- Input File ---
+BOOL OpenInputFile(InputFile* file, const char* path) {
+    DWORD sizeHigh = 0, sizeLow;
+    memset(file, 0, sizeof(*file));
+    file->hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file->hFile == INVALID_HANDLE_VALUE) {
+        DebugPrint("OpenInputFile: CreateFileA failed with error %lu.\n", GetLastError());
+        file->hFile = NULL;
+        return FALSE;
+    }
+    sizeLow = GetFileSize(file->hFile, &sizeHigh);
+    if (sizeLow == INVALID_FILE_SIZE && GetLastError() != NO_ERROR) {
+        CloseInputFile(file);
+        return FALSE;
+    }
+    file->size = ((ULONGLONG)sizeHigh << 32) | sizeLow;
+    if (file->size > 0) {
+        file->hMapping = CreateFileMappingA(file->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!file->hMapping) {
+            DebugPrint("OpenInputFile: CreateFileMappingA failed with error %lu.\n", GetLastError());
+            CloseInputFile(file);
+            return FALSE;
         }
-        params->output_buffer_pos = 0;
     }
+    return TRUE;
 }
 
-char* optimize_code(const char* code) {
-    size_t len = strlen(code);
-    char* ocode = (char*)malloc(len + 1);
-    if (!ocode)
-        return NULL;
-    size_t ocode_len = 0;
-    for (size_t i = 0; i < len; i++) { 
-        switch (code[i]) {
-            case '>': case '<': case '+': case '-':
-            case ',': case '.': case '[': case ']':
-                ocode[ocode_len++] = code[i];
-                break;
+// Input callback for the engine: replaces the current view with the next
+// INPUT_VIEW_SIZE bytes of the file. Mapping failures end the input.
+size_t MapNextInputView(void* context, const char** data) {
+    InputFile* file = (InputFile*)context;
+    ULONGLONG remaining = file->size - file->offset;
+    size_t length = remaining < INPUT_VIEW_SIZE ? (size_t)remaining : INPUT_VIEW_SIZE;
+
+    if (file->view) {
+        UnmapViewOfFile((LPCVOID)file->view);
+        file->view = NULL;
+    }
+    if (length == 0)
+        return 0;
+    file->view = (const char*)MapViewOfFile(file->hMapping, FILE_MAP_READ,
+                                            (DWORD)(file->offset >> 32), (DWORD)file->offset, length);
+    if (!file->view) {
+        DebugPrint("MapNextInputView: MapViewOfFile failed with error %lu.\n", GetLastError());
+        return 0;
+    }
+    file->offset += length;
+    *data = file->view;
+    return length;
+}
+
+void CloseInputFile(InputFile* file) {
+    if (file->view)
+        UnmapViewOfFile((LPCVOID)file->view);
+    if (file->hMapping)
+        CloseHandle(file->hMapping);
+    if (file->hFile)
+        CloseHandle(file->hFile);
+    memset(file, 0, sizeof(*file));
+}
+
+// Reflects the active session's szInputFile in the menu, the input label and
+// the input box, which is disabled while a file supplies standard input.
+void UpdateInputBinding(HWND hwnd) {
+    char strBuffer[MAX_STRING_LENGTH];
+    char labelBuffer[MAX_STRING_LENGTH + MAX_PATH];
+    Session* session = g_pActiveSession;
+    BOOL bound = session->szInputFile[0] != '\0';
+
+    CheckMenuItem(GetMenu(hwnd), IDM_FILE_INPUT_FILE, MF_BYCOMMAND | (bound ? MF_CHECKED : MF_UNCHECKED));
+    EnableWindow(session->hwndInputEdit, !bound);
+    if (bound) {
+        LoadStringFromResource(IDS_INPUT_FILE_LABEL, strBuffer, MAX_STRING_LENGTH);
+        sprintf(labelBuffer, strBuffer, session->szInputFile);
+    } else
+        LoadStringFromResource(IDS_INPUT_LABEL, labelBuffer, MAX_STRING_LENGTH);
+    SetDlgItemTextA(hwnd, IDC_STATIC_INPUT, labelBuffer);
+}
+
+// --- Interpreter Logic ---
+// Output callback for the engine: queues the buffer for the UI thread, which
+// drains it every OUTPUT_DRAIN_MS (see WM_TIMER). While the ring is full the
+// thread spins briefly and then sleeps until the UI catches up, so memory
+// use stays bounded however much the program prints.
+// A stopped or paused run still waits for the UI, so its output is shown and
+// matches what a checkpoint records; only a closed tab's output is dropped.
+void SendBufferedOutput(void* context, const char* data, size_t length) {
+    InterpreterParams* params = (InterpreterParams*)context;
+    Session* session = params->session;
+    int waits = 0;
+
+    while (length > 0) {
+        size_t written = WriteOutputRing(&session->outputRing, data, length);
+        data += written;
+        length -= written;
+        if (written > 0) {
+            waits = 0;
+        } else {
+            if (session->bClosed)
+                return;
+            Sleep(waits++ < OUTPUT_RING_SPINS ? 0 : 1);
         }
     }
-    ocode[ocode_len] = '\0';
-    return ocode;
+}
+
+// Writes a traced run's records to bftrace<tab>.bin in the temporary
+// directory and tells the session's output pane where they went.
+static void SaveRunTrace(InterpreterParams* params, const TraceRing* trace) {
+    char strBuffer[MAX_STRING_LENGTH];
+    char path[MAX_PATH], message[MAX_STRING_LENGTH + MAX_PATH + 48];
+    DWORD length = GetTempPathA(MAX_PATH - 24, path);
+    FILE* file = NULL;
+
+    if (length > 0 && length < MAX_PATH - 24) {
+        sprintf(path + length, "bftrace%d.bin", params->session->number);
+        file = fopen(path, "wb");
+    } else
+        strcpy(path, "bftrace.bin");
+    if (file && TraceRing_dump(trace, file) == BF_OK) {
+        // msvcrt has no %llu, so counts are printed as doubles.
+        unsigned long long kept = trace->count < trace->capacity ? trace->count : trace->capacity;
+        sprintf(message, LoadStringFromResource(IDS_TRACE_SAVED, strBuffer, MAX_STRING_LENGTH), (double)kept, (double)trace->count, path);
+    } else
+        sprintf(message, LoadStringFromResource(IDS_TRACE_ERROR, strBuffer, MAX_STRING_LENGTH), path);
+    if (file)
+        fclose(file);
+    PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(message));
+}
+
+// Saves a checkpoint to path through a temporary file, so a failed save
+// never replaces a good checkpoint with a partial one.
+static BOOL WriteCheckpointFile(const char* path, const Machine* machine, const Program* program) {
+    char temp[MAX_PATH + 8];
+    sprintf(temp, "%s.tmp", path);
+    FILE* file = fopen(temp, "wb");
+    if (!file)
+        return FALSE;
+    int status = Machine_save_checkpoint(machine, program, file);
+    if (fclose(file) != 0)
+        status = BF_ERR_IO;
+    if (status == BF_OK && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING))
+        return TRUE;
+    // Windows 9x has no MoveFileEx, so the old file is deleted first there.
+    if (status == BF_OK && GetLastError() == ERROR_CALL_NOT_IMPLEMENTED) {
+        DeleteFileA(path);
+        if (MoveFileA(temp, path))
+            return TRUE;
+    }
+    DeleteFileA(temp);
+    return FALSE;
+}
+
+// Machine.checkpoint_callback of runs with automatic checkpoints. A failed
+// save is reported in the session's output pane and the run carries on.
+static void SaveAutoCheckpoint(void* context, Machine* machine, const Program* program) {
+    InterpreterParams* params = (InterpreterParams*)context;
+    char strBuffer[MAX_STRING_LENGTH];
+    char message[MAX_STRING_LENGTH + MAX_PATH];
+    if (WriteCheckpointFile(params->checkpoint_path, machine, program))
+        return;
+    DebugPrint("SaveAutoCheckpoint: Failed to write %s.\n", params->checkpoint_path);
+    sprintf(message, LoadStringFromResource(IDS_CHECKPOINT_ERROR, strBuffer, MAX_STRING_LENGTH), params->checkpoint_path);
+    PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(message));
 }
 
 DWORD WINAPI InterpretThreadProc(LPVOID lpParam) {
     DebugPrintInterpreter("Interpreter thread started.\n");
     InterpreterParams* params = (InterpreterParams*)lpParam;
-    Tape tape;
-    Tape_init(&tape);
     char strBuffer[MAX_STRING_LENGTH];
+    const Program* program = NULL;
+    const ProgramPrefix* prefix = NULL;
+    int tape_mode = g_bLargeTape ? TAPE_LARGE : TAPE_WRAP;
+    int cell_width = g_nCellWidth;
+
+    int error_status;
+    if (params->code_path) {
+        // The program only refers back to source offsets, so the mapping can
+        // go as soon as it is compiled.
+        SourceFile source;
+        if (OpenSourceFile(&source, params->code_path)) {
+            program = AcquireCachedProgram(source.data ? source.data : "", source.length, tape_mode, cell_width, &prefix, &error_status);
+            CloseSourceFile(&source);
+        } else
+            error_status = BF_ERR_IO;
+    } else
+        program = AcquireCachedProgram(params->code, strlen(params->code), tape_mode, cell_width, &prefix, &error_status);
+    if (error_status == BF_ERR_IO) {
+        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(IDS_SOURCE_FILE_ERROR, strBuffer, MAX_STRING_LENGTH)));
+    } else if (error_status == BF_ERR_NO_MEMORY) {
+        DebugPrintInterpreter("InterpretThreadProc: Failed to compile code (memory allocation).\n");
+        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(IDS_MEM_ERROR_OPTIMIZE, strBuffer, MAX_STRING_LENGTH))); // Changed from _strdup
+    } else if (error_status == BF_ERR_MISMATCHED_BRACKETS) {
+        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(IDS_MISMATCHED_BRACKETS, strBuffer, MAX_STRING_LENGTH))); // Changed from _strdup
+    } else if (params->input_path && !OpenInputFile(&params->input_file, params->input_path)) {
+        error_status = BF_ERR_IO;
+        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(IDS_INPUT_FILE_ERROR, strBuffer, MAX_STRING_LENGTH)));
+        ReleaseCachedProgram(program);
+    } else if (Machine_init(&params->machine, tape_mode, cell_width) != BF_OK) {
+        error_status = BF_ERR_NO_MEMORY;
+        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(IDS_MEM_ERROR_TAPE, strBuffer, MAX_STRING_LENGTH)));
+        CloseInputFile(&params->input_file);
+        ReleaseCachedProgram(program);
+    } else {
+        Machine* machine = &params->machine;
+        machine->input = params->input;
+        machine->input_len = (size_t)params->input_len;
+        if (params->input_path) {
+            // Read in place from the mapping; nothing is copied into params->input.
+            machine->input_callback = MapNextInputView;
+            machine->input_context = &params->input_file;
+        }
+        machine->output_buffer = params->output_buffer;
+        machine->output_buffer_size = OUTPUT_BUFFER_SIZE;
+        machine->output_callback = SendBufferedOutput;
+        machine->output_context = params;
+        machine->running = &params->session->bRunning;
+        machine->step_limit = (unsigned long long)g_dwStepLimit * 1000000u;
+        machine->time_limit_ms = g_dwTimeLimit > 0xFFFFFFFFu / 1000u ? 0xFFFFFFFFu : g_dwTimeLimit * 1000u;
+        machine->output_limit = (unsigned long long)g_dwOutputLimit << 20;
+
+        // Only the reference interpreter counts instructions, so profiling
+        // overrides the engine setting. A failed allocation runs unprofiled.
+        int engine = g_nEngine;
+        if (g_bProfile) {
+            machine->counts = (unsigned long long*)calloc(program->length + 1, sizeof(unsigned long long));
+            if (machine->counts)
+                engine = ENGINE_SWITCH;
+            else
+                DebugPrint("InterpretThreadProc: Failed to allocate profile counters.\n");
+        }
 
-    char* ocode = optimize_code(params->code);
-    if (!ocode) {
-        DebugPrintInterpreter("InterpretThreadProc: Failed to optimize code (memory allocation).\n");
-        LoadStringFromResource(IDS_MEM_ERROR_OPTIMIZE, strBuffer, MAX_STRING_LENGTH);
-        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, 0, (LPARAM)strdup(strBuffer)); // Changed from _strdup
-        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_DONE, 1, 0);
-        free(params->code);
-        free(params->input);
-        free(params->output_buffer);
-        free(params);
-        g_bInterpreterRunning = FALSE;
-        return 1;
-    }
+        // Tracing also runs on the reference interpreter, see Machine_run_engine.
+        TraceRing trace = { NULL, 0, 0 };
+        if (g_bTrace) {
+            if (TraceRing_init(&trace, TRACE_RECORDS) == BF_OK)
+                machine->trace = &trace;
+            else
+                DebugPrint("InterpretThreadProc: Failed to allocate the trace buffer.\n");
+        }
 
-    size_t pc = 0;
-    size_t ocode_len = strlen(ocode);
-    int error_status = 0;
+        // Automatic checkpoints go to bfcheckpoint<tab>.bfc in the temporary directory.
+        params->checkpoint_path[0] = '\0';
+        if (g_dwCheckpointInterval > 0) {
+            DWORD length = GetTempPathA(MAX_PATH - 32, params->checkpoint_path);
+            if (length > 0 && length < MAX_PATH - 32) {
+                sprintf(params->checkpoint_path + length, "bfcheckpoint%d.bfc", params->session->number);
+                machine->checkpoint_interval_ms = g_dwCheckpointInterval > 0xFFFFFFFFu / 60000u ? 0xFFFFFFFFu : g_dwCheckpointInterval * 60000u;
+                machine->checkpoint_callback = SaveAutoCheckpoint;
+                machine->checkpoint_context = params;
+            } else
+                params->checkpoint_path[0] = '\0';
+        }
 
-    DebugPrintInterpreter("InterpretThreadProc: Starting main loop.\n");
-    while (pc < ocode_len && g_bInterpreterRunning && error_status == 0) { 
-        char current_instruction = ocode[pc];
-        DebugPrintInterpreter("PC: %zu, Instruction: %c\n", pc, current_instruction);
+        // Resuming replaces the fresh tape and skips the input read before the checkpoint.
+        int run_status = BF_OK;
+        if (params->resume_path[0] != '\0') {
+            FILE* file = fopen(params->resume_path, "rb");
+            run_status = file ? Machine_load_checkpoint(machine, program, file) : BF_ERR_IO;
+            if (file)
+                fclose(file);
+            if (run_status != BF_OK) {
+                char message[MAX_STRING_LENGTH + MAX_PATH];
+                sprintf(message, LoadStringFromResource(IDS_RESUME_ERROR, strBuffer, MAX_STRING_LENGTH), params->resume_path);
+                PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(message));
+            }
+        } else if (prefix && !machine->counts && !machine->trace && (!machine->step_limit || prefix->steps < machine->step_limit)) {
+            // A fresh run starts after the input-independent prefix evaluated
+            // at compile time. Profiled and traced runs need every step, and a
+            // step limit the prefix would reach is left to the engine.
+            if (Machine_apply_prefix(machine, prefix) == BF_OK)
+                DebugPrintInterpreter("InterpretThreadProc: Skipped %.0f instructions of input-independent prefix.\n", (double)prefix->steps);
+        }
 
-        switch (current_instruction) {
-            case '>': Tape_forward(&tape); pc++; break;
-            case '<': Tape_reverse(&tape); pc++; break;
-            case '+': Tape_inc(&tape); pc++; break;
-            case '-': Tape_dec(&tape); pc++; break;
-            case ',':
-                if (params->input_pos < params->input_len)
-                    Tape_set(&tape, (unsigned char)params->input[params->input_pos++]);
-                else
-                    Tape_set(&tape, 0);
-                pc++;
-                break;
-            case '.':
-                if (params->output_buffer_pos < OUTPUT_BUFFER_SIZE - 1)
-                    params->output_buffer[params->output_buffer_pos++] = Tape_get(&tape);
-                else {
-                    SendBufferedOutput(params);
-                    params->output_buffer[params->output_buffer_pos++] = Tape_get(&tape);
+        if (run_status == BF_OK) {
+            DebugPrintInterpreter("InterpretThreadProc: Starting main loop.\n");
+            run_status = Machine_run_engine(machine, program, engine);
+        }
+        if (run_status == BF_OK) {
+            DebugPrintInterpreter("InterpretThreadProc: Interpretation finished successfully.\n");
+            if (machine->counts) {
+                ProfileReport* report = (ProfileReport*)malloc(sizeof(ProfileReport));
+                if (report) {
+                    report->session = params->session;
+                    report->total = machine->steps;
+                    report->count = Program_profile_loops(program, machine->counts, report->loops, PROFILE_TOP_LOOPS);
+                    PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_PROFILE, (WPARAM)params->session, (LPARAM)report);
                 }
-                pc++;
-                break;
-            case '[':
-                if (Tape_get(&tape) == 0) {
-                    int bracket_count = 1;
-                    size_t current_pc_loop = pc; 
-                    while (bracket_count > 0 && ++current_pc_loop < ocode_len) {
-                        if (ocode[current_pc_loop] == '[')
-                            bracket_count++;
-                        else if (ocode[current_pc_loop] == ']')
-                            bracket_count--;
-                    }
-                    if (current_pc_loop >= ocode_len) {
-                        error_status = 1;
-                        DebugPrintInterpreter("InterpretThreadProc: Mismatched opening bracket.\n");
-                    } else {
-                        pc = current_pc_loop + 1;
-                    }
-                } else
-                    pc++;
-                break;
-            case ']':
-                if (Tape_get(&tape) != 0) {
-                    int bracket_count = 1;
-                    size_t current_pc_loop = pc; 
-                    while (bracket_count > 0) {
-                        if (current_pc_loop == 0) { 
-                            error_status = 1;
-                            DebugPrintInterpreter("InterpretThreadProc: Mismatched closing bracket (reached beginning).\n");
-                            break;
-                        }
-                        current_pc_loop--; 
-                        if (ocode[current_pc_loop] == ']')
-                            bracket_count++;
-                        else if (ocode[current_pc_loop] == '[')
-                            bracket_count--;
-                    }
-                     if (error_status == 0 && bracket_count != 0) { 
-                         error_status = 1;
-                         DebugPrintInterpreter("InterpretThreadProc: Mismatched closing bracket (loop ended unexpectedly).\n");
-                     } else if (error_status == 0) {
-                        pc = current_pc_loop; 
-                     }
-                } else
-                    pc++;
-                break;
+            }
+        } else {
+            UINT message = 0;
+            switch (run_status) {
+                case BF_STOPPED: message = IDS_RUN_STOPPED; break;
+                case BF_STEP_LIMIT: message = IDS_RUN_STEP_LIMIT; break;
+                case BF_TIME_LIMIT: message = IDS_RUN_TIME_LIMIT; break;
+                case BF_OUTPUT_LIMIT: message = IDS_RUN_OUTPUT_LIMIT; break;
+                case BF_ERR_NO_MEMORY: message = IDS_RUN_NO_MEMORY; break;
+            }
+            if (message)
+                PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(LoadStringFromResource(message, strBuffer, MAX_STRING_LENGTH)));
+
+            // A run that was stopped or reached a limit can be continued with
+            // File > Resume from Checkpoint. File > Pause to Checkpoint names
+            // the file itself.
+            const char* path = params->session->szCheckpointFile[0] != '\0' ? params->session->szCheckpointFile : params->checkpoint_path;
+            if (message && run_status != BF_ERR_NO_MEMORY && path[0] != '\0') {
+                char saved[MAX_STRING_LENGTH + MAX_PATH];
+                sprintf(saved, LoadStringFromResource(WriteCheckpointFile(path, machine, program) ? IDS_CHECKPOINT_SAVED : IDS_CHECKPOINT_ERROR, strBuffer, MAX_STRING_LENGTH), path);
+                PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, (WPARAM)params->session, (LPARAM)strdup(saved));
+            }
         }
-        if (!g_bInterpreterRunning) {
-            DebugPrintInterpreter("InterpretThreadProc: Stop signal received.\n");
-            break;
+        error_status = run_status;
+        if (machine->trace) {
+            SaveRunTrace(params, &trace);
+            TraceRing_free(&trace);
+            machine->trace = NULL;
         }
+        free(machine->counts);
+        machine->counts = NULL;
+        Machine_free(machine);
+        CloseInputFile(&params->input_file);
+        ReleaseCachedProgram(program);
     }
 
-    SendBufferedOutput(params);
-
-    if (error_status == 1)
-        PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_OUTPUT_STRING, 0, (LPARAM)strdup(LoadStringFromResource(IDS_MISMATCHED_BRACKETS, strBuffer, MAX_STRING_LENGTH))); // Changed from _strdup
-    else if (g_bInterpreterRunning)
-        DebugPrintInterpreter("InterpretThreadProc: Interpretation finished successfully.\n");
-
-    PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_DONE, error_status, 0);
-    free(ocode);
+    // The session may be freed as soon as the UI thread sees this message,
+    // so it is not touched again.
+    PostMessage(params->hwndMainWindow, WM_APP_INTERPRETER_DONE, (WPARAM)params->session, error_status);
     free(params->code);
+    free(params->code_path);
     free(params->input);
+    free(params->input_path);
     free(params->output_buffer);
     free(params);
-    g_bInterpreterRunning = FALSE;
     DebugPrintInterpreter("Interpreter thread exiting.\n");
     return error_status;
 }
 
+// Returns a malloc'd copy of an EDIT control's text, or NULL on failure.
+char* GetEditText(HWND hwndEdit, int* length) {
+    int len = GetWindowTextLengthA(hwndEdit);
+    char* text = (char*)malloc(len + 1);
+    if (!text)
+        return NULL;
+    GetWindowTextA(hwndEdit, text, len + 1);
+    if (length)
+        *length = len;
+    return text;
+}
+
+// Compiles the active session's code editor contents, or its bound program
+// file, reporting errors in a message box.
+BOOL CompileEditorCode(HWND hwnd, Program* program) {
+    char strBuffer[MAX_STRING_LENGTH];
+    Session* session = g_pActiveSession;
+    int status;
+    if (session->szProgramFile[0] != '\0') {
+        SourceFile source;
+        if (!OpenSourceFile(&source, session->szProgramFile)) {
+            MessageBoxA(hwnd, LoadStringFromResource(IDS_SOURCE_FILE_ERROR, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+            return FALSE;
+        }
+        status = Program_compile(program, source.data ? source.data : "", source.length);
+        CloseSourceFile(&source);
+    } else {
+        int code_len;
+        char* code_text = GetEditText(session->hwndCodeEdit, &code_len);
+        if (!code_text) {
+            MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_CODE, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+            return FALSE;
+        }
+        status = Program_compile(program, code_text, (size_t)code_len);
+        free(code_text);
+    }
+    if (status == BF_ERR_MISMATCHED_BRACKETS)
+        MessageBoxA(hwnd, LoadStringFromResource(IDS_MISMATCHED_BRACKETS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+    else if (status != BF_OK)
+        MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_OPTIMIZE, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+    return status == BF_OK;
+}
+
+BOOL ExportProgramToC(const Program* program, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        DebugPrint("ExportProgramToC: Could not open %s.\n", path);
+        return FALSE;
+    }
+    int status = Program_export_c(program, g_bLargeTape ? TAPE_LARGE_SIZE : TAPE_SIZE, g_nCellWidth, file);
+    if (fclose(file) != 0)
+        status = BF_ERR_IO;
+    return status == BF_OK;
+}
+
+// Exports the program to a temporary C file and compiles it with BF_CC.
+// Returns FALSE if the compiler could not be started; otherwise *exitCode
+// holds the compiler's exit code.
+BOOL BuildExecutable(const Program* program, const char* exePath, DWORD* exitCode) {
+    char tempDir[MAX_PATH], sourcePath[MAX_PATH];
+    char commandLine[MAX_PATH * 2 + 64];
+    STARTUPINFOA si = {0};
+    PROCESS_INFORMATION pi;
+
+    if (!GetTempPathA(sizeof(tempDir), tempDir) || !GetTempFileNameA(tempDir, "bf", 0, sourcePath))
+        return FALSE;
+    if (!ExportProgramToC(program, sourcePath)) {
+        DeleteFileA(sourcePath);
+        return FALSE;
+    }
+
+    // The temporary file has a .tmp extension, so name the language explicitly.
+    sprintf(commandLine, "%s -O2 -x c \"%s\" -o \"%s\"", BF_CC, sourcePath, exePath);
+    DebugPrint("BuildExecutable: Running %s\n", commandLine);
+    si.cb = sizeof(si);
+    if (!CreateProcessA(NULL, commandLine, NULL, NULL, FALSE, CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
+        DebugPrint("BuildExecutable: CreateProcessA failed with error %lu.\n", GetLastError());
+        DeleteFileA(sourcePath);
+        return FALSE;
+    }
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    GetExitCodeProcess(pi.hProcess, exitCode);
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    DeleteFileA(sourcePath);
+    return TRUE;
+}
+
 // --- Settings Dialog Procedure ---
 LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
     UNREFERENCED_PARAMETER(lParam); 
@@ -272,21 +668,58 @@ LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lPa
             HWND hCheckBasic = GetDlgItem(hwnd, IDC_CHECK_DEBUG_BASIC);
             HWND hCheckInterpreter = GetDlgItem(hwnd, IDC_CHECK_DEBUG_INTERPRETER);
             HWND hCheckOutput = GetDlgItem(hwnd, IDC_CHECK_DEBUG_OUTPUT);
+            HWND hCheckProfile = GetDlgItem(hwnd, IDC_CHECK_PROFILE);
+            HWND hCheckLargeTape = GetDlgItem(hwnd, IDC_CHECK_LARGE_TAPE);
+            HWND hCheckTrace = GetDlgItem(hwnd, IDC_CHECK_TRACE);
+            HWND hEngineLabel = GetDlgItem(hwnd, IDC_STATIC_ENGINE);
+            HWND hEngineCombo = GetDlgItem(hwnd, IDC_COMBO_ENGINE);
+            HWND hCellWidthLabel = GetDlgItem(hwnd, IDC_STATIC_CELL_WIDTH);
+            HWND hCellWidthCombo = GetDlgItem(hwnd, IDC_COMBO_CELL_WIDTH);
+            // The three run limits and the auto-checkpoint interval share one row layout.
+            HWND hLimitLabels[4] = { GetDlgItem(hwnd, IDC_STATIC_STEP_LIMIT), GetDlgItem(hwnd, IDC_STATIC_TIME_LIMIT), GetDlgItem(hwnd, IDC_STATIC_OUTPUT_LIMIT), GetDlgItem(hwnd, IDC_STATIC_CHECKPOINT) };
+            HWND hLimitEdits[4] = { GetDlgItem(hwnd, IDC_EDIT_STEP_LIMIT), GetDlgItem(hwnd, IDC_EDIT_TIME_LIMIT), GetDlgItem(hwnd, IDC_EDIT_OUTPUT_LIMIT), GetDlgItem(hwnd, IDC_EDIT_CHECKPOINT) };
+            const UINT limitLabelIds[4] = { IDS_STEP_LIMIT_LABEL, IDS_TIME_LIMIT_LABEL, IDS_OUTPUT_LIMIT_LABEL, IDS_CHECKPOINT_LABEL };
             HWND hOkButton = GetDlgItem(hwnd, IDOK);
 
             SetWindowTextA(hCheckBasic, LoadStringFromResource(IDS_DEBUG_BASIC_CHK, strBuffer, MAX_STRING_LENGTH));
             SetWindowTextA(hCheckInterpreter, LoadStringFromResource(IDS_DEBUG_INTERPRETER_CHK, strBuffer, MAX_STRING_LENGTH));
             SetWindowTextA(hCheckOutput, LoadStringFromResource(IDS_DEBUG_OUTPUT_CHK, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(hCheckProfile, LoadStringFromResource(IDS_PROFILE_CHK, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(hCheckLargeTape, LoadStringFromResource(IDS_LARGE_TAPE_CHK, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(hCheckTrace, LoadStringFromResource(IDS_TRACE_CHK, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(hEngineLabel, LoadStringFromResource(IDS_ENGINE_LABEL, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(hCellWidthLabel, LoadStringFromResource(IDS_CELL_WIDTH_LABEL, strBuffer, MAX_STRING_LENGTH));
+            for (int i = 0; i < 4; i++)
+                SetWindowTextA(hLimitLabels[i], LoadStringFromResource(limitLabelIds[i], strBuffer, MAX_STRING_LENGTH));
             SetWindowTextA(hOkButton, LoadStringFromResource(IDS_OK, strBuffer, MAX_STRING_LENGTH));
             SetWindowTextA(hwnd, LoadStringFromResource(IDS_SETTINGS_TITLE, strBuffer, MAX_STRING_LENGTH));
 
             CheckDlgButton(hwnd, IDC_CHECK_DEBUG_BASIC, g_bDebugBasic ? BST_CHECKED : BST_UNCHECKED);
             CheckDlgButton(hwnd, IDC_CHECK_DEBUG_INTERPRETER, g_bDebugInterpreter ? BST_CHECKED : BST_UNCHECKED);
             CheckDlgButton(hwnd, IDC_CHECK_DEBUG_OUTPUT, g_bDebugOutput ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hwnd, IDC_CHECK_PROFILE, g_bProfile ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hwnd, IDC_CHECK_LARGE_TAPE, g_bLargeTape ? BST_CHECKED : BST_UNCHECKED);
+            CheckDlgButton(hwnd, IDC_CHECK_TRACE, g_bTrace ? BST_CHECKED : BST_UNCHECKED);
+            SetDlgItemInt(hwnd, IDC_EDIT_STEP_LIMIT, g_dwStepLimit, FALSE);
+            SetDlgItemInt(hwnd, IDC_EDIT_TIME_LIMIT, g_dwTimeLimit, FALSE);
+            SetDlgItemInt(hwnd, IDC_EDIT_OUTPUT_LIMIT, g_dwOutputLimit, FALSE);
+            SetDlgItemInt(hwnd, IDC_EDIT_CHECKPOINT, g_dwCheckpointInterval, FALSE);
 
             EnableWindow(hCheckInterpreter, g_bDebugBasic);
             EnableWindow(hCheckOutput, g_bDebugBasic);
 
+            // Combo box items are added in ENGINE_* order so the selection index is the engine.
+            SendMessageA(hEngineCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_ENGINE_SWITCH, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hEngineCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_ENGINE_THREADED, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hEngineCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_ENGINE_JIT, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hEngineCombo, CB_SETCURSEL, (WPARAM)g_nEngine, 0);
+
+            // Likewise in CELL_* order.
+            SendMessageA(hCellWidthCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_CELL_8BIT, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hCellWidthCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_CELL_16BIT, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hCellWidthCombo, CB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_CELL_32BIT, strBuffer, MAX_STRING_LENGTH));
+            SendMessageA(hCellWidthCombo, CB_SETCURSEL, (WPARAM)g_nCellWidth, 0);
+
             HDC hdc = GetDC(hwnd);
             HFONT hFont = (HFONT)SendMessage(hwnd, WM_GETFONT, 0, 0);
             HFONT hOldFont = NULL;
@@ -312,8 +745,54 @@ LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lPa
             GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
             if (size.cx > maxCheckboxTextWidth) maxCheckboxTextWidth = size.cx;
 
+            GetWindowTextA(hCheckProfile, strBuffer, MAX_STRING_LENGTH);
+            GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+            if (size.cx > maxCheckboxTextWidth) maxCheckboxTextWidth = size.cx;
+
+            GetWindowTextA(hCheckLargeTape, strBuffer, MAX_STRING_LENGTH);
+            GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+            if (size.cx > maxCheckboxTextWidth) maxCheckboxTextWidth = size.cx;
+
+            GetWindowTextA(hCheckTrace, strBuffer, MAX_STRING_LENGTH);
+            GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+            if (size.cx > maxCheckboxTextWidth) maxCheckboxTextWidth = size.cx;
+
             int checkboxControlWidth = maxCheckboxTextWidth + GetSystemMetrics(SM_CXMENUCHECK) + 25; 
 
+            GetWindowTextA(hEngineLabel, strBuffer, MAX_STRING_LENGTH);
+            GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+            int labelWidth = size.cx + 10;
+            GetWindowTextA(hCellWidthLabel, strBuffer, MAX_STRING_LENGTH);
+            GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+            if (size.cx + 10 > labelWidth) labelWidth = size.cx + 10;
+            int maxComboTextWidth = 0;
+            for (UINT id = IDS_ENGINE_SWITCH; id <= IDS_ENGINE_JIT; id++) {
+                LoadStringFromResource(id, strBuffer, MAX_STRING_LENGTH);
+                GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+                if (size.cx > maxComboTextWidth) maxComboTextWidth = size.cx;
+            }
+            for (UINT id = IDS_CELL_8BIT; id <= IDS_CELL_32BIT; id++) {
+                LoadStringFromResource(id, strBuffer, MAX_STRING_LENGTH);
+                GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+                if (size.cx > maxComboTextWidth) maxComboTextWidth = size.cx;
+            }
+            int comboWidth = maxComboTextWidth + GetSystemMetrics(SM_CXVSCROLL) + 20;
+            int comboHeight = buttonHeight;
+            if (labelWidth + comboWidth > checkboxControlWidth)
+                checkboxControlWidth = labelWidth + comboWidth;
+
+            // The limit boxes sit at the right edge, sized for ten digits.
+            int limitLabelWidth = 0;
+            for (int i = 0; i < 4; i++) {
+                GetWindowTextA(hLimitLabels[i], strBuffer, MAX_STRING_LENGTH);
+                GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
+                if (size.cx + 10 > limitLabelWidth) limitLabelWidth = size.cx + 10;
+            }
+            GetTextExtentPoint32A(hdc, "0000000000", 10, &size);
+            int limitEditWidth = size.cx + 12;
+            if (limitLabelWidth + limitEditWidth > checkboxControlWidth)
+                checkboxControlWidth = limitLabelWidth + limitEditWidth;
+
             GetWindowTextA(hOkButton, strBuffer, MAX_STRING_LENGTH);
             GetTextExtentPoint32A(hdc, strBuffer, (int)strlen(strBuffer), &size);
             int okButtonWidth = size.cx + 50; 
@@ -330,8 +809,28 @@ LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lPa
             SetWindowPos(hCheckInterpreter, NULL, DLG_MARGIN, currentY, checkboxControlWidth, checkboxHeight, SWP_NOZORDER);
             currentY += checkboxHeight + CHECKBOX_V_SPACING;
             SetWindowPos(hCheckOutput, NULL, DLG_MARGIN, currentY, checkboxControlWidth, checkboxHeight, SWP_NOZORDER);
-            
-            currentY += checkboxHeight; 
+            currentY += checkboxHeight + CHECKBOX_V_SPACING;
+            SetWindowPos(hCheckProfile, NULL, DLG_MARGIN, currentY, checkboxControlWidth, checkboxHeight, SWP_NOZORDER);
+            currentY += checkboxHeight + CHECKBOX_V_SPACING;
+            SetWindowPos(hCheckLargeTape, NULL, DLG_MARGIN, currentY, checkboxControlWidth, checkboxHeight, SWP_NOZORDER);
+            currentY += checkboxHeight + CHECKBOX_V_SPACING;
+            SetWindowPos(hCheckTrace, NULL, DLG_MARGIN, currentY, checkboxControlWidth, checkboxHeight, SWP_NOZORDER);
+            currentY += checkboxHeight + CHECKBOX_V_SPACING;
+
+            // The combo box height includes its drop-down list.
+            SetWindowPos(hEngineLabel, NULL, DLG_MARGIN, currentY + (comboHeight - checkboxHeight) / 2, labelWidth, checkboxHeight, SWP_NOZORDER);
+            SetWindowPos(hEngineCombo, NULL, DLG_MARGIN + labelWidth, currentY, checkboxControlWidth - labelWidth, comboHeight * 6, SWP_NOZORDER);
+            currentY += comboHeight + CHECKBOX_V_SPACING;
+            SetWindowPos(hCellWidthLabel, NULL, DLG_MARGIN, currentY + (comboHeight - checkboxHeight) / 2, labelWidth, checkboxHeight, SWP_NOZORDER);
+            SetWindowPos(hCellWidthCombo, NULL, DLG_MARGIN + labelWidth, currentY, checkboxControlWidth - labelWidth, comboHeight * 6, SWP_NOZORDER);
+            currentY += comboHeight;
+
+            for (int i = 0; i < 4; i++) {
+                currentY += CHECKBOX_V_SPACING;
+                SetWindowPos(hLimitLabels[i], NULL, DLG_MARGIN, currentY + (comboHeight - checkboxHeight) / 2, checkboxControlWidth - limitEditWidth, checkboxHeight, SWP_NOZORDER);
+                SetWindowPos(hLimitEdits[i], NULL, DLG_MARGIN + checkboxControlWidth - limitEditWidth, currentY, limitEditWidth, comboHeight, SWP_NOZORDER);
+                currentY += comboHeight;
+            }
             currentY += CONTROLS_BUTTON_GAP; 
 
             int buttonStartX = (checkboxControlWidth + 2 * DLG_MARGIN - okButtonWidth) / 2;
@@ -370,7 +869,30 @@ LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lPa
                         g_bDebugInterpreter = FALSE;
                         g_bDebugOutput = FALSE;
                     }
-                    SaveDebugSettingsToRegistry();
+                    int engine = (int)SendDlgItemMessageA(hwnd, IDC_COMBO_ENGINE, CB_GETCURSEL, 0, 0);
+                    if (engine >= 0 && engine < ENGINE_COUNT)
+                        g_nEngine = engine;
+                    int cellWidth = (int)SendDlgItemMessageA(hwnd, IDC_COMBO_CELL_WIDTH, CB_GETCURSEL, 0, 0);
+                    if (cellWidth >= 0 && cellWidth < CELL_WIDTH_COUNT)
+                        g_nCellWidth = cellWidth;
+                    g_bProfile = IsDlgButtonChecked(hwnd, IDC_CHECK_PROFILE) == BST_CHECKED;
+                    g_bLargeTape = IsDlgButtonChecked(hwnd, IDC_CHECK_LARGE_TAPE) == BST_CHECKED;
+                    g_bTrace = IsDlgButtonChecked(hwnd, IDC_CHECK_TRACE) == BST_CHECKED;
+                    // ES_NUMBER only filters typing, so pasted text can still fail to parse.
+                    BOOL bParsed;
+                    UINT limit = GetDlgItemInt(hwnd, IDC_EDIT_STEP_LIMIT, &bParsed, FALSE);
+                    if (bParsed)
+                        g_dwStepLimit = limit;
+                    limit = GetDlgItemInt(hwnd, IDC_EDIT_TIME_LIMIT, &bParsed, FALSE);
+                    if (bParsed)
+                        g_dwTimeLimit = limit;
+                    limit = GetDlgItemInt(hwnd, IDC_EDIT_OUTPUT_LIMIT, &bParsed, FALSE);
+                    if (bParsed)
+                        g_dwOutputLimit = limit;
+                    limit = GetDlgItemInt(hwnd, IDC_EDIT_CHECKPOINT, &bParsed, FALSE);
+                    if (bParsed)
+                        g_dwCheckpointInterval = limit;
+                    SaveSettingsToRegistry();
                     EndDialog(hwnd, IDOK);
                     break;
                 case IDCANCEL: 
@@ -493,36 +1015,164 @@ LRESULT CALLBACK AboutDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam
     return (LRESULT)FALSE;
 }
 
+// Converts a character offset in the code editor to a 1-based line and column.
+// Lines are counted by newline rather than EM_LINEFROMCHAR, which reports
+// word-wrapped display lines.
+static void GetCodePosition(const char* text, size_t offset, int* line, int* column) {
+    const char* lineStart = text;
+    *line = 1;
+    for (const char* p = text; p < text + offset && *p; p++) {
+        if (*p == '\n') {
+            (*line)++;
+            lineStart = p + 1;
+        }
+    }
+    *column = (int)(text + offset - lineStart) + 1;
+}
+
+// --- Profile Dialog Procedure ---
+// lParam of WM_INITDIALOG is the ProfileReport, which outlives the dialog.
+LRESULT CALLBACK ProfileDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    char strBuffer[MAX_STRING_LENGTH];
+    char formatBuffer[MAX_STRING_LENGTH];
+
+    switch (uMsg) {
+        case WM_INITDIALOG:
+        {
+            DebugPrint("ProfileDlgProc: WM_INITDIALOG received.\n");
+            const ProfileReport* report = (const ProfileReport*)lParam;
+            HWND hList = GetDlgItem(hwnd, IDC_LIST_PROFILE);
+            SetWindowLongPtrA(hwnd, DWLP_USER, (LONG_PTR)report);
+
+            SetWindowTextA(hwnd, LoadStringFromResource(IDS_PROFILE_TITLE, strBuffer, MAX_STRING_LENGTH));
+            SetWindowTextA(GetDlgItem(hwnd, IDOK), LoadStringFromResource(IDS_OK, strBuffer, MAX_STRING_LENGTH));
+            // msvcrt has no %llu, so counts are printed as doubles.
+            LoadStringFromResource(IDS_PROFILE_SUMMARY, formatBuffer, MAX_STRING_LENGTH);
+            sprintf(strBuffer, formatBuffer, (double)report->total);
+            SetDlgItemTextA(hwnd, IDC_STATIC_PROFILE_SUMMARY, strBuffer);
+
+            // Offsets refer to the bound program file when there is one,
+            // not to the preview in the editor.
+            Session* session = report->session;
+            SourceFile source;
+            BOOL fromFile = session->szProgramFile[0] != '\0' && OpenSourceFile(&source, session->szProgramFile);
+            char* code = fromFile ? NULL : GetEditText(session->hwndCodeEdit, NULL);
+            const char* text = fromFile ? source.data : code;
+            size_t textLength = fromFile ? source.length : (code ? strlen(code) : 0);
+            LoadStringFromResource(IDS_PROFILE_ITEM, formatBuffer, MAX_STRING_LENGTH);
+            for (size_t i = 0; i < report->count; i++) {
+                const LoopProfile* loop = &report->loops[i];
+                int line = 0, column = 0;
+                if (text && loop->start < textLength)
+                    GetCodePosition(text, loop->start, &line, &column);
+                sprintf(strBuffer, formatBuffer, line, column,
+                        report->total ? 100.0 * (double)loop->instructions / (double)report->total : 0.0,
+                        (double)loop->instructions, (double)loop->iterations);
+                int index = (int)SendMessageA(hList, LB_ADDSTRING, 0, (LPARAM)strBuffer);
+                if (index >= 0)
+                    SendMessageA(hList, LB_SETITEMDATA, (WPARAM)index, (LPARAM)i);
+            }
+            free(code);
+            if (fromFile)
+                CloseSourceFile(&source);
+            if (report->count == 0) {
+                SendMessageA(hList, LB_ADDSTRING, 0, (LPARAM)LoadStringFromResource(IDS_PROFILE_NO_LOOPS, strBuffer, MAX_STRING_LENGTH));
+                EnableWindow(hList, FALSE);
+            }
+
+            RECT rcOwner, rcDlg;
+            GetWindowRect(GetParent(hwnd), &rcOwner);
+            GetWindowRect(hwnd, &rcDlg);
+            int dialogWidth = rcDlg.right - rcDlg.left;
+            int dialogHeight = rcDlg.bottom - rcDlg.top;
+            int newX = rcOwner.left + (rcOwner.right - rcOwner.left - dialogWidth) / 2;
+            int newY = rcOwner.top + (rcOwner.bottom - rcOwner.top - dialogHeight) / 2;
+            SetWindowPos(hwnd, HWND_TOP, newX, newY, 0, 0, SWP_NOSIZE | SWP_SHOWWINDOW);
+            return (LRESULT)TRUE;
+        }
+        case WM_COMMAND:
+            switch (LOWORD(wParam)) {
+                case IDOK:
+                case IDCANCEL:
+                    EndDialog(hwnd, LOWORD(wParam));
+                    break;
+                case IDC_LIST_PROFILE:
+                    // Selecting a loop selects its source range, [ through ],
+                    // in the session's code editor, which keeps it visible via ES_NOHIDESEL.
+                    if (HIWORD(wParam) == LBN_SELCHANGE) {
+                        const ProfileReport* report = (const ProfileReport*)GetWindowLongPtrA(hwnd, DWLP_USER);
+                        HWND hList = (HWND)lParam;
+                        int index = (int)SendMessageA(hList, LB_GETCURSEL, 0, 0);
+                        if (index < 0 || !report)
+                            break;
+                        size_t item = (size_t)SendMessageA(hList, LB_GETITEMDATA, (WPARAM)index, 0);
+                        if (item >= report->count)
+                            break;
+                        const LoopProfile* loop = &report->loops[item];
+                        HWND hwndCode = report->session->hwndCodeEdit;
+                        if (loop->end >= (size_t)GetWindowTextLengthA(hwndCode))
+                            break; // Beyond the preview of a program file
+                        SendMessageA(hwndCode, EM_SETSEL, (WPARAM)loop->start, (LPARAM)(loop->end + 1));
+                        SendMessageA(hwndCode, EM_SCROLLCARET, 0, 0);
+                    }
+                    break;
+            }
+            return (LRESULT)TRUE;
+        case WM_CLOSE:
+            EndDialog(hwnd, IDCANCEL);
+            return (LRESULT)TRUE;
+    }
+    return (LRESULT)FALSE;
+}
+
 // --- Registry Functions ---
-void SaveDebugSettingsToRegistry() {
+void SaveSettingsToRegistry() {
     HKEY hKey;
     LONG lResult;
-    DebugPrint("SaveDebugSettingsToRegistry: Attempting to open/create registry key.\n");
+    DebugPrint("SaveSettingsToRegistry: Attempting to open/create registry key.\n");
     lResult = RegCreateKeyExA(HKEY_CURRENT_USER, REG_APP_KEY_ANSI, 0, NULL, REG_OPTION_NON_VOLATILE, KEY_WRITE, NULL, &hKey, NULL);
     if (lResult != ERROR_SUCCESS) {
-        DebugPrint("SaveDebugSettingsToRegistry: RegCreateKeyExA failed with error %lu.\n", lResult);
+        DebugPrint("SaveSettingsToRegistry: RegCreateKeyExA failed with error %lu.\n", lResult);
         return;
     }
     DWORD dwDebugBasic = g_bDebugBasic ? 1 : 0;
     DWORD dwDebugInterpreter = g_bDebugInterpreter ? 1 : 0;
     DWORD dwDebugOutput = g_bDebugOutput ? 1 : 0;
+    DWORD dwEngine = (DWORD)g_nEngine;
+    DWORD dwProfile = g_bProfile ? 1 : 0;
+    DWORD dwLargeTape = g_bLargeTape ? 1 : 0;
+    DWORD dwCellWidth = (DWORD)g_nCellWidth;
+    DWORD dwStepLimit = g_dwStepLimit;
+    DWORD dwTimeLimit = g_dwTimeLimit;
+    DWORD dwOutputLimit = g_dwOutputLimit;
+    DWORD dwTrace = g_bTrace ? 1 : 0;
+    DWORD dwCheckpointInterval = g_dwCheckpointInterval;
 
     RegSetValueExA(hKey, REG_VALUE_DEBUG_BASIC_ANSI, 0, REG_DWORD, (const BYTE*)&dwDebugBasic, sizeof(dwDebugBasic));
     RegSetValueExA(hKey, REG_VALUE_DEBUG_INTERPRETER_ANSI, 0, REG_DWORD, (const BYTE*)&dwDebugInterpreter, sizeof(dwDebugInterpreter));
     RegSetValueExA(hKey, REG_VALUE_DEBUG_OUTPUT_ANSI, 0, REG_DWORD, (const BYTE*)&dwDebugOutput, sizeof(dwDebugOutput));
+    RegSetValueExA(hKey, REG_VALUE_ENGINE_ANSI, 0, REG_DWORD, (const BYTE*)&dwEngine, sizeof(dwEngine));
+    RegSetValueExA(hKey, REG_VALUE_PROFILE_ANSI, 0, REG_DWORD, (const BYTE*)&dwProfile, sizeof(dwProfile));
+    RegSetValueExA(hKey, REG_VALUE_LARGE_TAPE_ANSI, 0, REG_DWORD, (const BYTE*)&dwLargeTape, sizeof(dwLargeTape));
+    RegSetValueExA(hKey, REG_VALUE_CELL_WIDTH_ANSI, 0, REG_DWORD, (const BYTE*)&dwCellWidth, sizeof(dwCellWidth));
+    RegSetValueExA(hKey, REG_VALUE_STEP_LIMIT_ANSI, 0, REG_DWORD, (const BYTE*)&dwStepLimit, sizeof(dwStepLimit));
+    RegSetValueExA(hKey, REG_VALUE_TIME_LIMIT_ANSI, 0, REG_DWORD, (const BYTE*)&dwTimeLimit, sizeof(dwTimeLimit));
+    RegSetValueExA(hKey, REG_VALUE_OUTPUT_LIMIT_ANSI, 0, REG_DWORD, (const BYTE*)&dwOutputLimit, sizeof(dwOutputLimit));
+    RegSetValueExA(hKey, REG_VALUE_TRACE_ANSI, 0, REG_DWORD, (const BYTE*)&dwTrace, sizeof(dwTrace));
+    RegSetValueExA(hKey, REG_VALUE_CHECKPOINT_ANSI, 0, REG_DWORD, (const BYTE*)&dwCheckpointInterval, sizeof(dwCheckpointInterval));
     RegCloseKey(hKey);
-    DebugPrint("SaveDebugSettingsToRegistry: Registry key closed.\n");
+    DebugPrint("SaveSettingsToRegistry: Registry key closed.\n");
 }
 
-void LoadDebugSettingsFromRegistry() {
+void LoadSettingsFromRegistry() {
     HKEY hKey;
     LONG lResult;
     DWORD dwType, dwSize, dwValue;
 
-    DebugPrint("LoadDebugSettingsFromRegistry: Attempting to open registry key.\n");
+    DebugPrint("LoadSettingsFromRegistry: Attempting to open registry key.\n");
     lResult = RegOpenKeyExA(HKEY_CURRENT_USER, REG_APP_KEY_ANSI, 0, KEY_READ, &hKey);
     if (lResult != ERROR_SUCCESS) {
-        DebugPrint("LoadDebugSettingsFromRegistry: RegOpenKeyExA failed with error %lu. Using default settings.\n", lResult);
+        DebugPrint("LoadSettingsFromRegistry: RegOpenKeyExA failed with error %lu. Using default settings.\n", lResult);
         return;
     }
 
@@ -535,15 +1185,238 @@ void LoadDebugSettingsFromRegistry() {
     dwSize = sizeof(dwValue);
     if (RegQueryValueExA(hKey, REG_VALUE_DEBUG_OUTPUT_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
         g_bDebugOutput = (dwValue != 0);
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_ENGINE_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD && dwValue < ENGINE_COUNT)
+        g_nEngine = (int)dwValue;
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_PROFILE_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_bProfile = (dwValue != 0);
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_LARGE_TAPE_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_bLargeTape = (dwValue != 0);
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_CELL_WIDTH_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD && dwValue < CELL_WIDTH_COUNT)
+        g_nCellWidth = (int)dwValue;
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_STEP_LIMIT_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_dwStepLimit = dwValue;
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_TIME_LIMIT_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_dwTimeLimit = dwValue;
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_OUTPUT_LIMIT_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_dwOutputLimit = dwValue;
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_TRACE_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_bTrace = (dwValue != 0);
+    dwSize = sizeof(dwValue);
+    if (RegQueryValueExA(hKey, REG_VALUE_CHECKPOINT_ANSI, NULL, &dwType, (LPBYTE)&dwValue, &dwSize) == ERROR_SUCCESS && dwType == REG_DWORD)
+        g_dwCheckpointInterval = dwValue;
 
     if (!g_bDebugBasic) {
         g_bDebugInterpreter = FALSE;
         g_bDebugOutput = FALSE;
     }
     RegCloseKey(hKey);
-    DebugPrint("LoadDebugSettingsFromRegistry: Registry key closed.\n");
+    DebugPrint("LoadSettingsFromRegistry: Registry key closed.\n");
+}
+
+
+// --- Sessions ---
+// Every tab of hwndTabControl is a Session, stored as the item's lParam. Each
+// session has its own editors and output view, and runs its program on its
+// own thread with its own stop flag, so tabs never wait on each other.
+
+static int FindSessionTab(const Session* session) {
+    int count = (int)SendMessageA(hwndTabControl, TCM_GETITEMCOUNT, 0, 0);
+    for (int i = 0; i < count; i++) {
+        TCITEMA item = {0};
+        item.mask = TCIF_PARAM;
+        if (SendMessageA(hwndTabControl, TCM_GETITEMA, (WPARAM)i, (LPARAM)&item) && (const Session*)item.lParam == session)
+            return i;
+    }
+    return -1;
+}
+
+static Session* GetSessionAt(int index) {
+    TCITEMA item = {0};
+    item.mask = TCIF_PARAM;
+    if (index < 0 || !SendMessageA(hwndTabControl, TCM_GETITEMA, (WPARAM)index, (LPARAM)&item))
+        return NULL;
+    return (Session*)item.lParam;
+}
+
+static void ShowSessionControls(const Session* session, int nCmdShow) {
+    ShowWindow(session->hwndCodeEdit, nCmdShow);
+    ShowWindow(session->hwndInputEdit, nCmdShow);
+    ShowWindow(session->hwndOutputEdit, nCmdShow);
+}
+
+// Sizes the tab strip, the labels and the active session's controls to the
+// client area. The tab strip is only as tall as its row of tabs; the
+// session's controls sit below it rather than inside it.
+static void LayoutMainWindow(HWND hwnd, int width, int height) {
+    Session* session = g_pActiveSession;
+    int margin = 10, labelHeight = 20, editTopMargin = 5, spacing = 10, minEditHeight = 30;
+    int currentY = margin;
+
+    RECT rcTabs = { 0, 0, width - 2 * margin, 0 };
+    SendMessageA(hwndTabControl, TCM_ADJUSTRECT, TRUE, (LPARAM)&rcTabs);
+    int tabHeight = rcTabs.bottom - rcTabs.top;
+    MoveWindow(hwndTabControl, margin, currentY, width - 2 * margin, tabHeight, TRUE);
+    currentY += tabHeight + editTopMargin;
+
+    MoveWindow(GetDlgItem(hwnd, IDC_STATIC_CODE), margin, currentY, width - 2 * margin, labelHeight, TRUE);
+    currentY += labelHeight + editTopMargin;
+    int codeEditHeight = height / 4;
+    if (codeEditHeight < minEditHeight)
+        codeEditHeight = minEditHeight;
+    if (session)
+        MoveWindow(session->hwndCodeEdit, margin, currentY, width - 2 * margin, codeEditHeight, TRUE);
+    currentY += codeEditHeight + spacing;
+
+    MoveWindow(GetDlgItem(hwnd, IDC_STATIC_INPUT), margin, currentY, width - 2 * margin, labelHeight, TRUE);
+    currentY += labelHeight + editTopMargin;
+    int inputEditHeight = height / 6;
+    if (inputEditHeight < minEditHeight)
+        inputEditHeight = minEditHeight;
+    if (session)
+        MoveWindow(session->hwndInputEdit, margin, currentY, width - 2 * margin, inputEditHeight, TRUE);
+    currentY += inputEditHeight + spacing;
+
+    MoveWindow(GetDlgItem(hwnd, IDC_STATIC_OUTPUT), margin, currentY, width - 2 * margin, labelHeight, TRUE);
+    currentY += labelHeight + editTopMargin;
+    int outputEditHeight = height - currentY - margin;
+    if (outputEditHeight < minEditHeight)
+        outputEditHeight = minEditHeight;
+    if (session)
+        MoveWindow(session->hwndOutputEdit, margin, currentY, width - 2 * margin, outputEditHeight, TRUE);
 }
 
+// Sets the session's tab label, which shows whether its program is running
+// or its last run failed. A run stopped or paused by the user did not fail.
+void UpdateSessionTab(Session* session) {
+    char strBuffer[MAX_STRING_LENGTH];
+    char labelBuffer[MAX_STRING_LENGTH + 16];
+    int index = FindSessionTab(session);
+    int label = IDS_SESSION_TAB;
+    if (index < 0)
+        return;
+    if (session->bBusy)
+        label = IDS_SESSION_TAB_RUNNING;
+    else if (session->lastStatus != BF_OK && session->lastStatus != BF_STOPPED)
+        label = IDS_SESSION_TAB_FAILED;
+    LoadStringFromResource(label, strBuffer, MAX_STRING_LENGTH);
+    sprintf(labelBuffer, strBuffer, session->number);
+    TCITEMA item = {0};
+    item.mask = TCIF_TEXT;
+    item.pszText = labelBuffer;
+    SendMessageA(hwndTabControl, TCM_SETITEMA, (WPARAM)index, (LPARAM)&item);
+}
+
+// Creates a session with hidden controls and appends its tab. Returns NULL
+// if memory or a window cannot be had.
+Session* CreateSession(HWND hwnd) {
+    static int nextNumber = 1;
+    char strBuffer[MAX_STRING_LENGTH];
+    Session* session = (Session*)calloc(1, sizeof(Session));
+    if (!session)
+        return NULL;
+    if (!InitOutputRing(&session->outputRing)) {
+        free(session);
+        return NULL;
+    }
+
+    session->hwndCodeEdit = CreateWindowExA(WS_EX_CLIENTEDGE, WC_EDITA, "",
+        WS_CHILD | WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | ES_WANTRETURN | ES_NOHIDESEL | WS_TABSTOP,
+        10, 35, 560, 125, hwnd, (HMENU)IDC_EDIT_CODE, hInst, NULL);
+    session->hwndInputEdit = CreateWindowExA(WS_EX_CLIENTEDGE, WC_EDITA, "",
+        WS_CHILD | WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | ES_WANTRETURN | WS_TABSTOP,
+        10, 195, 560, 95, hwnd, (HMENU)IDC_EDIT_INPUT, hInst, NULL);
+    session->hwndOutputEdit = CreateWindowExA(WS_EX_CLIENTEDGE, OUTPUT_VIEW_CLASS, "",
+        WS_CHILD | WS_VSCROLL | WS_HSCROLL | WS_TABSTOP,
+        10, 325, 560, 150, hwnd, (HMENU)IDC_EDIT_OUTPUT, hInst, NULL);
+    if (!session->hwndCodeEdit || !session->hwndInputEdit || !session->hwndOutputEdit) {
+        DestroySession(session);
+        return NULL;
+    }
+    if (hMonoFont) {
+        SendMessageA(session->hwndCodeEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
+        SendMessageA(session->hwndInputEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
+        SendMessageA(session->hwndOutputEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
+    }
+    SetWindowTextA(session->hwndCodeEdit, LoadStringFromResource(IDS_DEFAULT_CODE, strBuffer, MAX_STRING_LENGTH));
+    SetWindowTextA(session->hwndInputEdit, LoadStringFromResource(IDS_DEFAULT_INPUT, strBuffer, MAX_STRING_LENGTH));
+
+    TCITEMA item = {0};
+    item.mask = TCIF_TEXT | TCIF_PARAM;
+    item.pszText = "";
+    item.lParam = (LPARAM)session;
+    int count = (int)SendMessageA(hwndTabControl, TCM_GETITEMCOUNT, 0, 0);
+    if ((int)SendMessageA(hwndTabControl, TCM_INSERTITEMA, (WPARAM)count, (LPARAM)&item) < 0) {
+        DestroySession(session);
+        return NULL;
+    }
+    session->number = nextNumber++;
+    UpdateSessionTab(session);
+    return session;
+}
+
+// Frees a session that has no tab and no running thread.
+void DestroySession(Session* session) {
+    CancelAnalysis(session);
+    if (session->hwndCodeEdit)
+        DestroyWindow(session->hwndCodeEdit);
+    if (session->hwndInputEdit)
+        DestroyWindow(session->hwndInputEdit);
+    if (session->hwndOutputEdit)
+        DestroyWindow(session->hwndOutputEdit);
+    free(session->outputRing.data);
+    free(session);
+}
+
+// Shows the session's controls in place of the active session's and selects
+// its tab.
+void SelectSession(HWND hwnd, Session* session) {
+    RECT rcClient;
+    if (g_pActiveSession && g_pActiveSession != session)
+        ShowSessionControls(g_pActiveSession, SW_HIDE);
+    g_pActiveSession = session;
+    SendMessageA(hwndTabControl, TCM_SETCURSEL, (WPARAM)FindSessionTab(session), 0);
+    GetClientRect(hwnd, &rcClient);
+    LayoutMainWindow(hwnd, rcClient.right, rcClient.bottom);
+    ShowSessionControls(session, SW_SHOW);
+    UpdateProgramBinding(hwnd);
+    UpdateInputBinding(hwnd);
+    SetFocus(session->hwndCodeEdit);
+}
+
+// Removes the session's tab and stops its run; a running session is freed
+// when its thread reports back. Closing the last tab opens an empty one in
+// its place. Returns FALSE if that fails and the tab stays open.
+BOOL CloseSession(HWND hwnd, Session* session) {
+    int index = FindSessionTab(session);
+    int count = (int)SendMessageA(hwndTabControl, TCM_GETITEMCOUNT, 0, 0);
+    Session* replacement = NULL;
+
+    if (count == 1 && !(replacement = CreateSession(hwnd)))
+        return FALSE;
+    SendMessageA(hwndTabControl, TCM_DELETEITEM, (WPARAM)index, 0);
+    KillTimer(hwnd, (UINT_PTR)session);
+    ShowSessionControls(session, SW_HIDE);
+    if (session == g_pActiveSession) {
+        g_pActiveSession = NULL;
+        if (!replacement)
+            replacement = GetSessionAt(index < count - 1 ? index : index - 1);
+        SelectSession(hwnd, replacement);
+    }
+    if (session->bBusy) {
+        session->bClosed = TRUE;
+        session->bRunning = FALSE;
+    } else
+        DestroySession(session);
+    return TRUE;
+}
 
 // --- Window Procedure ---
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -570,6 +1443,10 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 DebugPrint("WM_CREATE: SystemParametersInfoA for NONCLIENTMETRICS failed. Using default GUI font for labels.\n");
             }
 
+            hwndTabControl = CreateWindowA(WC_TABCONTROLA, "", WS_CHILD | WS_VISIBLE | WS_CLIPSIBLINGS | WS_TABSTOP,
+                          10, 10, 560, 24, hwnd, (HMENU)IDC_TAB_SESSIONS, hInst, NULL);
+            SendMessageA(hwndTabControl, WM_SETFONT, (WPARAM)GetStockObject(DEFAULT_GUI_FONT), TRUE);
+
             HWND hStaticCode = CreateWindowA(WC_STATICA, LoadStringFromResource(IDS_CODE_LABEL, strBuffer, MAX_STRING_LENGTH), WS_CHILD | WS_VISIBLE | SS_LEFTNOWORDWRAP,
                           10, 10, 100, 20, hwnd, (HMENU)IDC_STATIC_CODE, hInst, NULL);
             if (hLabelFont)
@@ -585,71 +1462,98 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             if (hLabelFont)
                 SendMessageA(hStaticOutput, WM_SETFONT, (WPARAM)hLabelFont, TRUE);
 
-            hwndCodeEdit = CreateWindowExA(WS_EX_CLIENTEDGE, WC_EDITA, "",
-                WS_CHILD | WS_VISIBLE | WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | ES_WANTRETURN | WS_TABSTOP,
-                10, 35, 560, 125, hwnd, (HMENU)IDC_EDIT_CODE, hInst, NULL);
-            if (hMonoFont)
-                SendMessageA(hwndCodeEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
-
-            hwndInputEdit = CreateWindowExA(WS_EX_CLIENTEDGE, WC_EDITA, "",
-                WS_CHILD | WS_VISIBLE | WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | ES_WANTRETURN | WS_TABSTOP,
-                10, 195, 560, 95, hwnd, (HMENU)IDC_EDIT_INPUT, hInst, NULL);
-            if (hMonoFont)
-                SendMessageA(hwndInputEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
+            if (!StartAnalysisWorker(hwnd))
+                DebugPrint("WM_CREATE: Failed to start the analysis thread.\n");
 
-            hwndOutputEdit = CreateWindowExA(WS_EX_CLIENTEDGE, WC_EDITA, "",
-                WS_CHILD | WS_VISIBLE | WS_VSCROLL | ES_MULTILINE | ES_AUTOVSCROLL | WS_TABSTOP, 
-                10, 325, 560, 150, hwnd, (HMENU)IDC_EDIT_OUTPUT, hInst, NULL);
-            if (hMonoFont)
-                SendMessageA(hwndOutputEdit, WM_SETFONT, (WPARAM)hMonoFont, TRUE);
-
-            SetWindowTextA(hwndCodeEdit, LoadStringFromResource(IDS_DEFAULT_CODE, strBuffer, MAX_STRING_LENGTH));
-            SetWindowTextA(hwndInputEdit, LoadStringFromResource(IDS_DEFAULT_INPUT, strBuffer, MAX_STRING_LENGTH));
-            
-            SetFocus(hwndCodeEdit);
+            Session* session = CreateSession(hwnd);
+            if (!session) {
+                MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_PARAMS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+                return -1;
+            }
+            SelectSession(hwnd, session);
             break;
         }
         case WM_SIZE:
-        { 
-            int width = LOWORD(lParam);
-            int height = HIWORD(lParam);
-            int margin = 10, labelHeight = 20, editTopMargin = 5, spacing = 10, minEditHeight = 30;
-            int currentY = margin;
-
-            MoveWindow(GetDlgItem(hwnd, IDC_STATIC_CODE), margin, currentY, width - 2 * margin, labelHeight, TRUE);
-            currentY += labelHeight + editTopMargin;
-            int codeEditHeight = height / 4;
-            if (codeEditHeight < minEditHeight)
-                codeEditHeight = minEditHeight;
-            MoveWindow(hwndCodeEdit, margin, currentY, width - 2 * margin, codeEditHeight, TRUE);
-            currentY += codeEditHeight + spacing;
-
-            MoveWindow(GetDlgItem(hwnd, IDC_STATIC_INPUT), margin, currentY, width - 2 * margin, labelHeight, TRUE);
-            currentY += labelHeight + editTopMargin;
-            int inputEditHeight = height / 6;
-            if (inputEditHeight < minEditHeight)
-                inputEditHeight = minEditHeight;
-            MoveWindow(hwndInputEdit, margin, currentY, width - 2 * margin, inputEditHeight, TRUE);
-            currentY += inputEditHeight + spacing;
-
-            MoveWindow(GetDlgItem(hwnd, IDC_STATIC_OUTPUT), margin, currentY, width - 2 * margin, labelHeight, TRUE);
-            currentY += labelHeight + editTopMargin;
-            int outputEditHeight = height - currentY - margin;
-            if (outputEditHeight < minEditHeight)
-                outputEditHeight = minEditHeight;
-            MoveWindow(hwndOutputEdit, margin, currentY, width - 2 * margin, outputEditHeight, TRUE); 
+            LayoutMainWindow(hwnd, LOWORD(lParam), HIWORD(lParam));
             break;
+        case WM_NOTIFY:
+        {
+            const NMHDR* header = (const NMHDR*)lParam;
+            if (header->hwndFrom == hwndTabControl && header->code == TCN_SELCHANGE) {
+                Session* session = GetSessionAt((int)SendMessageA(hwndTabControl, TCM_GETCURSEL, 0, 0));
+                if (session)
+                    SelectSession(hwnd, session);
+            }
+            return 0;
         }
         case WM_COMMAND:
         { 
             int wmId = LOWORD(wParam);
+            Session* session = g_pActiveSession;
             switch (wmId) {
                 case IDM_FILE_NEW:
-                    SetWindowTextA(hwndCodeEdit, "");
-                    SetWindowTextA(hwndInputEdit, "");
-                    SetWindowTextA(hwndOutputEdit, "");
-                    SetFocus(hwndCodeEdit);
+                    SetWindowTextA(session->hwndCodeEdit, "");
+                    SetWindowTextA(session->hwndInputEdit, "");
+                    SetWindowTextA(session->hwndOutputEdit, "");
+                    session->szInputFile[0] = '\0';
+                    UpdateInputBinding(hwnd);
+                    session->szProgramFile[0] = '\0';
+                    UpdateProgramBinding(hwnd);
+                    SetFocus(session->hwndCodeEdit);
+                    break;
+                case IDM_FILE_NEW_TAB:
+                {
+                    Session* created = CreateSession(hwnd);
+                    if (created)
+                        SelectSession(hwnd, created);
+                    else
+                        MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_PARAMS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+                    break;
+                }
+                case IDM_FILE_CLOSE_TAB:
+                    if (!CloseSession(hwnd, session))
+                        MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_PARAMS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+                    break;
+                case IDM_FILE_STOP:
+                    // Only this session's thread polls the flag.
+                    session->bRunning = FALSE;
+                    break;
+                case IDM_FILE_PAUSE_CHECKPOINT:
+                case IDM_FILE_RESUME_CHECKPOINT:
+                {
+                    // Pausing stops the run like File > Stop, after telling the
+                    // thread where to save its state. Resuming starts a run from
+                    // a saved state with the session's current program and input.
+                    BOOL pause = LOWORD(wParam) == IDM_FILE_PAUSE_CHECKPOINT;
+                    if (session->bBusy != pause)
+                        break;
+                    OPENFILENAMEA ofn = {0};
+                    ofn.lStructSize = sizeof(ofn);
+                    ofn.hwndOwner = hwnd;
+                    ofn.lpstrFile = fileBuffer;
+                    fileBuffer[0] = '\0';
+                    ofn.nMaxFile = sizeof(fileBuffer);
+                    ofn.lpstrFilter = "Checkpoints (*.bfc)\0*.bfc\0All Files (*.*)\0*.*\0";
+                    ofn.nFilterIndex = 1;
+                    ofn.lpstrDefExt = "bfc";
+                    if (pause) {
+                        ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT | OFN_HIDEREADONLY;
+                        ofn.lpstrTitle = LoadStringFromResource(IDS_PAUSE_CHECKPOINT_TITLE, strBuffer, MAX_STRING_LENGTH);
+                        // The run may have ended while the dialog was open.
+                        if (GetSaveFileNameA(&ofn) == TRUE && session->bBusy) {
+                            strcpy(session->szCheckpointFile, fileBuffer);
+                            session->bRunning = FALSE;
+                        }
+                    } else {
+                        ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_HIDEREADONLY;
+                        ofn.lpstrTitle = LoadStringFromResource(IDS_RESUME_CHECKPOINT_TITLE, strBuffer, MAX_STRING_LENGTH);
+                        if (GetOpenFileNameA(&ofn) == TRUE && !session->bBusy) {
+                            strcpy(session->szResumeFile, fileBuffer);
+                            SendMessageA(hwnd, WM_COMMAND, IDM_FILE_RUN, 0);
+                        }
+                    }
                     break;
+                }
                 case IDM_FILE_OPEN:
                 { 
                     OPENFILENAMEA ofn = {0};
@@ -666,83 +1570,191 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     if (GetOpenFileNameA(&ofn) == TRUE) {
                         HANDLE hFile = CreateFileA(ofn.lpstrFile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
                         if (hFile != INVALID_HANDLE_VALUE) {
-                            DWORD fileSize = GetFileSize(hFile, NULL);
-                            if (fileSize != INVALID_FILE_SIZE && fileSize < 1024 * 1024) { 
+                            DWORD sizeHigh = 0;
+                            DWORD fileSize = GetFileSize(hFile, &sizeHigh);
+                            if (fileSize == INVALID_FILE_SIZE && GetLastError() != NO_ERROR)
+                                 MessageBoxA(hwnd, "Error getting file size.", "File Error", MB_OK | MB_ICONERROR);
+                            else if (sizeHigh != 0 || fileSize >= SOURCE_PREVIEW_LIMIT)
+                                BindProgramFile(hwnd, ofn.lpstrFile); // Too big for the editor
+                            else {
                                 char* pFileContent = (char*)malloc(fileSize + 1);
                                 if (pFileContent) {
                                     DWORD bytesRead;
                                     if (ReadFile(hFile, pFileContent, fileSize, &bytesRead, NULL)) {
                                         pFileContent[bytesRead] = '\0';
-                                        SetWindowTextA(hwndCodeEdit, pFileContent);
+                                        session->szProgramFile[0] = '\0';
+                                        UpdateProgramBinding(hwnd);
+                                        SetWindowTextA(session->hwndCodeEdit, pFileContent);
                                     } else
                                          MessageBoxA(hwnd, "Error reading file.", "File Error", MB_OK | MB_ICONERROR);
                                     free(pFileContent);
                                 } else
                                     MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_CODE, strBuffer, MAX_STRING_LENGTH), "Memory Error", MB_OK | MB_ICONERROR);
-                            } else
-                                 MessageBoxA(hwnd, "File too large or error getting size.", "File Error", MB_OK | MB_ICONERROR);
+                            }
                             CloseHandle(hFile);
                         } else
                             MessageBoxA(hwnd, "Error opening file.", "File Error", MB_OK | MB_ICONERROR);
                     }
                     break;
                 }
+                case IDM_FILE_RUN_FILE:
+                {
+                    // Runs a file of any size without loading it into the editor.
+                    OPENFILENAMEA ofn = {0};
+                    ofn.lStructSize = sizeof(ofn);
+                    ofn.hwndOwner = hwnd;
+                    ofn.lpstrFile = fileBuffer;
+                    fileBuffer[0] = '\0';
+                    ofn.nMaxFile = sizeof(fileBuffer);
+                    ofn.lpstrFilter = "Brainfuck Source (*.bf;*.b)\0*.bf;*.b\0All Files (*.*)\0*.*\0";
+                    ofn.nFilterIndex = 1;
+                    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_HIDEREADONLY;
+                    ofn.lpstrTitle = LoadStringFromResource(IDS_RUN_FILE_TITLE, strBuffer, MAX_STRING_LENGTH);
+                    if (!session->bBusy && GetOpenFileNameA(&ofn) == TRUE && BindProgramFile(hwnd, fileBuffer))
+                        SendMessageA(hwnd, WM_COMMAND, IDM_FILE_RUN, 0);
+                    break;
+                }
+                case IDM_FILE_INPUT_FILE:
+                {
+                    // Choosing the checked item again goes back to the input box.
+                    if (session->szInputFile[0] != '\0') {
+                        session->szInputFile[0] = '\0';
+                        UpdateInputBinding(hwnd);
+                        break;
+                    }
+                    OPENFILENAMEA ofn = {0};
+                    ofn.lStructSize = sizeof(ofn);
+                    ofn.hwndOwner = hwnd;
+                    ofn.lpstrFile = fileBuffer;
+                    fileBuffer[0] = '\0';
+                    ofn.nMaxFile = sizeof(fileBuffer);
+                    ofn.lpstrFilter = "All Files (*.*)\0*.*\0";
+                    ofn.nFilterIndex = 1;
+                    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_HIDEREADONLY;
+                    ofn.lpstrTitle = LoadStringFromResource(IDS_INPUT_FILE_TITLE, strBuffer, MAX_STRING_LENGTH);
+                    if (GetOpenFileNameA(&ofn) == TRUE) {
+                        strcpy(session->szInputFile, fileBuffer);
+                        UpdateInputBinding(hwnd);
+                    }
+                    break;
+                }
                 case IDM_FILE_SETTINGS:
                     DialogBox(hInst, MAKEINTRESOURCE(IDD_SETTINGS), hwnd, SettingsDlgProc);
                     break;
                 case IDM_FILE_RUN:
                 { 
-                    if (!g_bInterpreterRunning) {
-                        SetWindowTextA(hwndOutputEdit, ""); 
-                        int code_len = GetWindowTextLengthA(hwndCodeEdit);
+                    if (!session->bBusy) {
+                        SetWindowTextA(session->hwndOutputEdit, ""); 
+                        // A bound program file is mapped by the thread; the editor only holds a preview.
+                        BOOL codeFromFile = session->szProgramFile[0] != '\0';
+                        int code_len = codeFromFile ? 0 : GetWindowTextLengthA(session->hwndCodeEdit);
                         char* code_text = (char*)malloc(code_len + 1);
-                        int input_len = GetWindowTextLengthA(hwndInputEdit);
+                        char* code_path = codeFromFile ? strdup(session->szProgramFile) : NULL;
+                        // A bound input file is opened by the thread; the input box is skipped.
+                        BOOL inputFromFile = session->szInputFile[0] != '\0';
+                        int input_len = inputFromFile ? 0 : GetWindowTextLengthA(session->hwndInputEdit);
                         char* input_text = (char*)malloc(input_len + 1);
+                        char* input_path = inputFromFile ? strdup(session->szInputFile) : NULL;
                         InterpreterParams* params = (InterpreterParams*)malloc(sizeof(InterpreterParams));
 
-                        if (!code_text || !input_text || !params) {
+                        if (!code_text || !input_text || !params || (inputFromFile && !input_path) || (codeFromFile && !code_path)) {
                             MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_PARAMS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK);
-                            free(code_text); free(input_text); free(params);
+                            free(code_text); free(code_path); free(input_text); free(input_path); free(params);
                             break;
                         }
-                        GetWindowTextA(hwndCodeEdit, code_text, code_len + 1);
-                        GetWindowTextA(hwndInputEdit, input_text, input_len + 1);
+                        if (codeFromFile)
+                            code_text[0] = '\0';
+                        else
+                            GetWindowTextA(session->hwndCodeEdit, code_text, code_len + 1);
+                        if (inputFromFile)
+                            input_text[0] = '\0';
+                        else
+                            GetWindowTextA(session->hwndInputEdit, input_text, input_len + 1);
 
                         params->hwndMainWindow = hwnd;
+                        params->session = session;
                         params->code = code_text; 
+                        params->code_path = code_path;
                         params->input = input_text;
                         params->input_len = input_len;
-                        params->input_pos = 0;
+                        params->input_path = input_path;
+                        memset(&params->input_file, 0, sizeof(params->input_file));
+                        strcpy(params->resume_path, session->szResumeFile);
+                        session->szResumeFile[0] = '\0';
                         params->output_buffer = (char*)malloc(OUTPUT_BUFFER_SIZE);
                         if (!params->output_buffer) {
                              MessageBoxA(hwnd, LoadStringFromResource(IDS_MEM_ERROR_PARAMS, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK); 
-                             free(code_text); free(input_text); free(params);
+                             free(code_text); free(code_path); free(input_text); free(input_path); free(params);
                              break;
                         }
-                        params->output_buffer_pos = 0;
 
-                        g_bInterpreterRunning = TRUE;
-                        g_hInterpreterThread = CreateThread(NULL, 0, InterpretThreadProc, params, 0, NULL);
-                        if (g_hInterpreterThread == NULL) {
-                            g_bInterpreterRunning = FALSE;
+                        // Output still queued from the previous run was already
+                        // cleared from the window along with the rest.
+                        ResetOutputRing(&session->outputRing);
+                        session->bRunning = TRUE;
+                        HANDLE hThread = CreateThread(NULL, 0, InterpretThreadProc, params, 0, NULL);
+                        if (hThread == NULL) {
+                            session->bRunning = FALSE;
                             MessageBoxA(hwnd, LoadStringFromResource(IDS_THREAD_ERROR, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK);
-                            free(code_text); free(input_text); free(params->output_buffer); free(params);
+                            free(code_text); free(code_path); free(input_text); free(input_path); free(params->output_buffer); free(params);
                         } else {
-                            CloseHandle(g_hInterpreterThread); 
-                            g_hInterpreterThread = NULL;
+                            CloseHandle(hThread); 
+                            session->bBusy = TRUE;
+                            UpdateSessionTab(session);
+                            SetTimer(hwnd, OUTPUT_TIMER_ID, OUTPUT_DRAIN_MS, NULL);
                         }
                     }
                     break;
                 }
+                case IDM_FILE_EXPORT_C:
+                case IDM_FILE_BUILD_EXE:
+                {
+                    Program program;
+                    if (!CompileEditorCode(hwnd, &program))
+                        break;
+                    OPENFILENAMEA ofn = {0};
+                    ofn.lStructSize = sizeof(ofn);
+                    ofn.hwndOwner = hwnd;
+                    ofn.lpstrFile = fileBuffer;
+                    fileBuffer[0] = '\0';
+                    ofn.nMaxFile = sizeof(fileBuffer);
+                    ofn.Flags = OFN_PATHMUSTEXIST | OFN_HIDEREADONLY | OFN_OVERWRITEPROMPT;
+                    if (wmId == IDM_FILE_EXPORT_C) {
+                        ofn.lpstrFilter = "C Source (*.c)\0*.c\0All Files (*.*)\0*.*\0";
+                        ofn.lpstrDefExt = "c";
+                        ofn.lpstrTitle = LoadStringFromResource(IDS_EXPORT_C_TITLE, strBuffer, MAX_STRING_LENGTH);
+                    } else {
+                        ofn.lpstrFilter = "Executable (*.exe)\0*.exe\0All Files (*.*)\0*.*\0";
+                        ofn.lpstrDefExt = "exe";
+                        ofn.lpstrTitle = LoadStringFromResource(IDS_BUILD_EXE_TITLE, strBuffer, MAX_STRING_LENGTH);
+                    }
+                    if (GetSaveFileNameA(&ofn) == TRUE) {
+                        if (wmId == IDM_FILE_EXPORT_C) {
+                            if (!ExportProgramToC(&program, fileBuffer))
+                                MessageBoxA(hwnd, LoadStringFromResource(IDS_EXPORT_ERROR, strBuffer, MAX_STRING_LENGTH), "Error", MB_OK | MB_ICONERROR);
+                        } else {
+                            DWORD exitCode = 1;
+                            HCURSOR hOldCursor = SetCursor(LoadCursor(NULL, IDC_WAIT));
+                            BOOL started = BuildExecutable(&program, fileBuffer, &exitCode);
+                            SetCursor(hOldCursor);
+                            if (started && exitCode == 0)
+                                MessageBoxA(hwnd, LoadStringFromResource(IDS_BUILD_SUCCEEDED, strBuffer, MAX_STRING_LENGTH), "Build", MB_OK | MB_ICONINFORMATION);
+                            else
+                                MessageBoxA(hwnd, LoadStringFromResource(IDS_BUILD_FAILED, strBuffer, MAX_STRING_LENGTH), "Build", MB_OK | MB_ICONERROR);
+                        }
+                    }
+                    Program_free(&program);
+                    break;
+                }
                 case IDM_FILE_COPYOUTPUT:
                 { 
-                    int textLen = GetWindowTextLengthA(hwndOutputEdit);
+                    int textLen = GetWindowTextLengthA(session->hwndOutputEdit);
                     if (textLen > 0) {
                         HGLOBAL hGlobal = GlobalAlloc(GMEM_MOVEABLE | GMEM_DDESHARE, textLen + 1);
                         if (hGlobal) {
                             char* pText = (char*)GlobalLock(hGlobal);
                             if (pText) {
-                                GetWindowTextA(hwndOutputEdit, pText, textLen + 1);
+                                GetWindowTextA(session->hwndOutputEdit, pText, textLen + 1);
                                 GlobalUnlock(hGlobal);
                                 if (OpenClipboard(hwnd)) {
                                     EmptyClipboard();
@@ -762,7 +1774,7 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     break;
                 }
                 case IDM_FILE_CLEAROUTPUT:
-                    SetWindowTextA(hwndOutputEdit, "");
+                    SetWindowTextA(session->hwndOutputEdit, "");
                     break;
                 case IDM_FILE_EXIT:
                     DestroyWindow(hwnd);
@@ -773,62 +1785,141 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 case IDM_EDIT_SELECTALL:
                 {
                     HWND hFocused = GetFocus();
-                    if (hFocused == hwndCodeEdit || hFocused == hwndInputEdit || hFocused == hwndOutputEdit)
+                    if (hFocused == session->hwndCodeEdit || hFocused == session->hwndInputEdit)
                         SendMessage(hFocused, EM_SETSEL, 0, -1);
                     break;
                 }
                 case IDM_HELP_ABOUT:
                     DialogBox(hInst, MAKEINTRESOURCE(IDD_ABOUT), hwnd, AboutDlgProc);
                     break;
+                case IDC_EDIT_CODE:
+                    // Each edit restarts the session's timer, so the code is
+                    // analyzed once typing pauses. See WM_TIMER. A tab's first
+                    // text is set before it becomes the active session.
+                    if (HIWORD(wParam) == EN_CHANGE && session && (HWND)lParam == session->hwndCodeEdit)
+                        SetTimer(hwnd, (UINT_PTR)session, ANALYSIS_DELAY_MS, NULL);
+                    break;
                 default:
                     return DefWindowProc(hwnd, uMsg, wParam, lParam);
             }
             break;
         }
+        case WM_TIMER:
+        {
+            // WM_TIMER is only generated when no other message is queued, so
+            // draining output here never holds up input or painting. The
+            // timer stops once no tab is running.
+            if (wParam == OUTPUT_TIMER_ID) {
+                // The running tabs share one OUTPUT_DRAIN_BUDGET_MS; each
+                // gets at least one snapshot.
+                BOOL busy = FALSE;
+                DWORD start = GetTickCount();
+                int count = (int)SendMessageA(hwndTabControl, TCM_GETITEMCOUNT, 0, 0);
+                for (int i = 0; i < count; i++) {
+                    Session* session = GetSessionAt(i);
+                    if (session && session->bBusy) {
+                        DWORD elapsed = GetTickCount() - start;
+                        DrainOutputRing(&session->outputRing, session->hwndOutputEdit, elapsed < OUTPUT_DRAIN_BUDGET_MS ? OUTPUT_DRAIN_BUDGET_MS - elapsed : 0);
+                        busy = TRUE;
+                    }
+                }
+                if (!busy)
+                    KillTimer(hwnd, OUTPUT_TIMER_ID);
+                break;
+            }
+            // The other timers are the analysis timers, identified by their Session.
+            Session* session = (Session*)wParam;
+            KillTimer(hwnd, wParam);
+            if (FindSessionTab(session) >= 0)
+                RequestAnalysis(session);
+            break;
+        }
         case WM_CTLCOLORSTATIC:
              return (LRESULT)GetStockObject(NULL_BRUSH);
+        // Messages for a closed tab's session are dropped until its thread
+        // reports that it is done.
         case WM_APP_INTERPRETER_OUTPUT_STRING:
         { 
             DebugPrintOutput("WM_APP_INTERPRETER_OUTPUT_STRING received.\n");
+            Session* session = (Session*)wParam;
             LPCSTR szString = (LPCSTR)lParam;
             if (szString) {
-                size_t original_len = strlen(szString);
-                char* converted_string = (char*)malloc(original_len * 2 + 1); 
-                if (converted_string) {
-                    char* p_in = (char*)szString;
-                    char* p_out = converted_string;
-                    while (*p_in) {
-                        if (*p_in == '\n' && (p_in == szString || *(p_in -1) != '\r')) {
-                            *p_out++ = '\r';
-                        }
-                        *p_out++ = *p_in++;
-                    }
-                    *p_out = '\0';
-                    AppendTextToEditControl(hwndOutputEdit, converted_string);
-                    free(converted_string);
-                } else
-                     AppendTextToEditControl(hwndOutputEdit, "\r\nError: Mem alloc for output conversion failed.\r\n");
+                // The thread wrote any output before it posted the message,
+                // so one drain puts the message after that output.
+                if (!session->bClosed) {
+                    DrainOutputRing(&session->outputRing, session->hwndOutputEdit, 0);
+                    AppendOutputText(session->hwndOutputEdit, szString);
+                }
                 free((void*)lParam); 
             }
-            SendMessageA(hwndOutputEdit, EM_SCROLLCARET, 0, 0); 
+            return 0;
+        }
+        case WM_APP_INTERPRETER_PROFILE:
+        {
+            DebugPrint("WM_APP_INTERPRETER_PROFILE received.\n");
+            Session* session = (Session*)wParam;
+            if (!session->bClosed) {
+                // Loops are highlighted in the session's editor, so show it.
+                if (session != g_pActiveSession)
+                    SelectSession(hwnd, session);
+                DialogBoxParamA(hInst, MAKEINTRESOURCEA(IDD_PROFILE), hwnd, ProfileDlgProc, lParam);
+            }
+            free((void*)lParam);
             return 0;
         }
         case WM_APP_INTERPRETER_DONE:
+        {
             DebugPrint("WM_APP_INTERPRETER_DONE received.\n");
-            g_bInterpreterRunning = FALSE;
+            Session* session = (Session*)wParam;
+            if (session->bClosed) {
+                DestroySession(session);
+                break;
+            }
+            DrainOutputRing(&session->outputRing, session->hwndOutputEdit, 0);
+            session->szCheckpointFile[0] = '\0';
+            session->lastStatus = (int)lParam;
+            session->bBusy = FALSE;
+            session->bRunning = FALSE;
+            UpdateSessionTab(session);
+            break;
+        }
+        case WM_APP_ANALYSIS_DONE:
+        {
+            // Results for closed tabs, or overtaken by a later edit, are dropped.
+            Session* session = (Session*)wParam;
+            AnalysisResult* result = (AnalysisResult*)lParam;
+            if (FindSessionTab(session) >= 0 && result->sequence == session->analysisSequence) {
+                if (result->status == BF_ERR_MISMATCHED_BRACKETS)
+                    sprintf(session->szCodeError, LoadStringFromResource(IDS_CODE_ERROR_LABEL, strBuffer, MAX_STRING_LENGTH), result->bracket, result->line, result->column);
+                else
+                    session->szCodeError[0] = '\0';
+                if (session == g_pActiveSession)
+                    UpdateProgramBinding(hwnd);
+            }
+            free(result);
             break;
+        }
         case WM_CLOSE:
             DestroyWindow(hwnd);
             return 0;
         case WM_DESTROY:
+        {
             DebugPrint("WM_DESTROY received.\n");
-            g_bInterpreterRunning = FALSE; 
+            // Running threads still use their sessions, so stop them but
+            // leave the sessions to the process exit.
+            int count = (int)SendMessageA(hwndTabControl, TCM_GETITEMCOUNT, 0, 0);
+            for (int i = 0; i < count; i++) {
+                Session* session = GetSessionAt(i);
+                if (session)
+                    session->bRunning = FALSE;
+            }
             if (hMonoFont)
                 DeleteObject(hMonoFont);
             if (hLabelFont)
                 DeleteObject(hLabelFont);
             PostQuitMessage(0);
             break;
+        }
         default:
             return DefWindowProc(hwnd, uMsg, wParam, lParam);
     }
@@ -852,7 +1943,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         return 1;
     }
 
-    LoadDebugSettingsFromRegistry();
+    LoadSettingsFromRegistry();
+    InitProgramCache();
 
     const char MAIN_WINDOW_CLASS_NAME[] = "BFInterpreterWindowClassResource";
     WNDCLASSA wc = {0};
@@ -865,7 +1957,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     wc.style = CS_HREDRAW | CS_VREDRAW;
     wc.hIcon = LoadIcon(hInstance, IDI_APPLICATION); 
 
-    if (!RegisterClassA(&wc)) {
+    if (!RegisterClassA(&wc) || !RegisterOutputViewClass(hInstance)) {
         MessageBoxA(NULL, LoadStringFromResource(IDS_WINDOW_REG_ERROR, strBuffer, MAX_STRING_LENGTH), "Error", MB_ICONEXCLAMATION | MB_OK);
         return 0;
     }
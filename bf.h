@@ -22,6 +22,8 @@
 #include <winreg.h>   // Include for Registry functions
 // <wchar.h> and <strsafe.h> are intentionally omitted for strict ANSI/Win95.
 
+#include "bfengine.h" // Portable compiler and execution engine
+
 // Resource IDs - These will correspond to IDs in bf.rc
 // Menu IDs
 #define IDM_MAINMENU        1000 // Main menu resource ID
@@ -37,6 +39,15 @@
 #define IDM_EDIT_PASTE      1010
 #define IDM_EDIT_SELECTALL  1011
 #define IDM_HELP_ABOUT      1012
+#define IDM_FILE_EXPORT_C   1013
+#define IDM_FILE_BUILD_EXE  1014
+#define IDM_FILE_INPUT_FILE 1015
+#define IDM_FILE_RUN_FILE   1016
+#define IDM_FILE_NEW_TAB    1017
+#define IDM_FILE_CLOSE_TAB  1018
+#define IDM_FILE_STOP       1019
+#define IDM_FILE_PAUSE_CHECKPOINT  1020
+#define IDM_FILE_RESUME_CHECKPOINT 1021
 
 // Control IDs for Main Window
 #define IDC_STATIC_CODE     2001
@@ -45,19 +56,40 @@
 #define IDC_EDIT_INPUT      2004
 #define IDC_STATIC_OUTPUT   2005
 #define IDC_EDIT_OUTPUT     2006
+#define IDC_TAB_SESSIONS    2007
 
 // Dialog IDs
 #define IDD_SETTINGS        3000
 #define IDD_ABOUT           4000
+#define IDD_PROFILE         6000
 
 // Control IDs for Settings Dialog
 #define IDC_CHECK_DEBUG_BASIC       3001
 #define IDC_CHECK_DEBUG_INTERPRETER 3002
 #define IDC_CHECK_DEBUG_OUTPUT      3003
+#define IDC_STATIC_ENGINE           3004
+#define IDC_COMBO_ENGINE            3005
+#define IDC_CHECK_PROFILE           3006
+#define IDC_CHECK_LARGE_TAPE        3007
+#define IDC_STATIC_CELL_WIDTH       3008
+#define IDC_COMBO_CELL_WIDTH        3009
+#define IDC_STATIC_STEP_LIMIT       3010
+#define IDC_EDIT_STEP_LIMIT         3011
+#define IDC_STATIC_TIME_LIMIT       3012
+#define IDC_EDIT_TIME_LIMIT         3013
+#define IDC_STATIC_OUTPUT_LIMIT     3014
+#define IDC_EDIT_OUTPUT_LIMIT       3015
+#define IDC_CHECK_TRACE             3016
+#define IDC_STATIC_CHECKPOINT       3017
+#define IDC_EDIT_CHECKPOINT         3018
 
 // Control IDs for About Dialog
 #define IDC_STATIC_ABOUT_TEXT 4001
 
+// Control IDs for Profile Dialog
+#define IDC_STATIC_PROFILE_SUMMARY 6001
+#define IDC_LIST_PROFILE           6002
+
 // Accelerator Table ID
 #define IDA_ACCELERATORS    5000
 
@@ -108,18 +140,102 @@
 #define IDS_EDIT_PASTE_MENU             44
 #define IDS_EDIT_SELECTALL_MENU         45
 #define IDS_HELP_ABOUT_MENU             46
+#define IDS_ENGINE_LABEL                47
+#define IDS_ENGINE_SWITCH               48
+#define IDS_ENGINE_THREADED             49
+#define IDS_ENGINE_JIT                  50
+#define IDS_FILE_EXPORT_C_MENU          51
+#define IDS_FILE_BUILD_EXE_MENU         52
+#define IDS_EXPORT_C_TITLE              53
+#define IDS_BUILD_EXE_TITLE             54
+#define IDS_EXPORT_ERROR                55
+#define IDS_BUILD_FAILED                56
+#define IDS_BUILD_SUCCEEDED             57
+#define IDS_PROFILE_CHK                 58
+#define IDS_PROFILE_TITLE               59
+#define IDS_PROFILE_SUMMARY             60
+#define IDS_PROFILE_ITEM                61
+#define IDS_PROFILE_NO_LOOPS            62
+#define IDS_FILE_INPUT_FILE_MENU        63
+#define IDS_INPUT_FILE_TITLE            64
+#define IDS_INPUT_FILE_LABEL            65
+#define IDS_INPUT_FILE_ERROR            66
+#define IDS_FILE_RUN_FILE_MENU          67
+#define IDS_RUN_FILE_TITLE              68
+#define IDS_CODE_FILE_LABEL             69
+#define IDS_SOURCE_FILE_ERROR           70
+#define IDS_LARGE_TAPE_CHK              71
+#define IDS_MEM_ERROR_TAPE              72
+#define IDS_CELL_WIDTH_LABEL            73
+#define IDS_CELL_8BIT                   74
+#define IDS_CELL_16BIT                  75
+#define IDS_CELL_32BIT                  76
+#define IDS_FILE_NEW_TAB_MENU           77
+#define IDS_FILE_CLOSE_TAB_MENU         78
+#define IDS_FILE_STOP_MENU              79
+#define IDS_SESSION_TAB                 80
+#define IDS_SESSION_TAB_RUNNING         81
+#define IDS_RUN_STOPPED                 82
+#define IDS_STEP_LIMIT_LABEL            83
+#define IDS_TIME_LIMIT_LABEL            84
+#define IDS_OUTPUT_LIMIT_LABEL          85
+#define IDS_RUN_STEP_LIMIT              86
+#define IDS_RUN_TIME_LIMIT              87
+#define IDS_RUN_OUTPUT_LIMIT            88
+#define IDS_TRACE_CHK                   89
+#define IDS_TRACE_SAVED                 90
+#define IDS_TRACE_ERROR                 91
+#define IDS_FILE_PAUSE_CHECKPOINT_MENU  92
+#define IDS_FILE_RESUME_CHECKPOINT_MENU 93
+#define IDS_CHECKPOINT_LABEL            94
+#define IDS_CHECKPOINT_SAVED            95
+#define IDS_CHECKPOINT_ERROR            96
+#define IDS_RESUME_ERROR                97
+#define IDS_PAUSE_CHECKPOINT_TITLE      98
+#define IDS_RESUME_CHECKPOINT_TITLE     99
+#define IDS_CODE_ERROR_LABEL            100
+#define IDS_RUN_NO_MEMORY               101
+#define IDS_SESSION_TAB_FAILED          102
 
 // Manifest ID
 #define IDR_MANIFEST 1
 
 // --- Custom Messages for Thread Communication ---
-#define WM_APP_INTERPRETER_OUTPUT_STRING (WM_APP + 2)
-#define WM_APP_INTERPRETER_DONE          (WM_APP + 3)
+// wParam is always the Session the interpreter thread runs for.
+#define WM_APP_INTERPRETER_OUTPUT_STRING (WM_APP + 2) // lParam is a malloc'd string
+#define WM_APP_INTERPRETER_DONE          (WM_APP + 3) // lParam is the status; the last message of a run
+#define WM_APP_INTERPRETER_PROFILE       (WM_APP + 4) // lParam is a malloc'd ProfileReport
+// Sent by the analysis thread in bfcache.c. The Session may have been closed
+// since, so it is only looked at while it still has a tab.
+#define WM_APP_ANALYSIS_DONE             (WM_APP + 6) // lParam is a malloc'd AnalysisResult
+
+// --- Output View Control (bfview.c) ---
+// Also handles WM_SETTEXT, WM_GETTEXT and WM_GETTEXTLENGTH like an EDIT control.
+#define OUTPUT_VIEW_CLASS "BFOutputView"
+#define OVM_APPEND (WM_USER + 1) // wParam: length, lParam: const char* text
 
 // --- Constants ---
-#define TAPE_SIZE           65536
 #define OUTPUT_BUFFER_SIZE  1024
 #define MAX_STRING_LENGTH   512
+#define PROFILE_TOP_LOOPS   10
+#define TRACE_RECORDS       (1 << 20) // Steps kept by a traced run, 16 MB
+#define OUTPUT_RING_SIZE    (256 * 1024) // Must be a power of two
+#define OUTPUT_RING_SPINS   64           // Sleep(0) retries on a full ring before Sleep(1)
+#define INPUT_VIEW_SIZE     (16 * 1024 * 1024) // Bytes of an input file mapped at a time; a multiple of 64 KiB
+#define SOURCE_PREVIEW_LIMIT (1024 * 1024) // Opened files this large run from the file
+#define SOURCE_PREVIEW_SIZE (32 * 1024)     // Bytes of such a file shown in the editor
+#define PROGRAM_CACHE_SIZE  8                // Compiled programs kept for reruns, see bfcache.c
+#define PROGRAM_CACHE_BYTES (256 * 1024 * 1024) // Total bytecode and prefix state they may hold
+#define PREFIX_STEP_BUDGET  (1 << 24) // Instructions evaluated ahead when a program first runs
+#define ANALYSIS_DELAY_MS   300 // Pause in typing before the code is analyzed
+#define OUTPUT_TIMER_ID     1   // Drains the output rings; analysis timers use Session pointers
+#define OUTPUT_DRAIN_MS     16  // Interval between output drains while a run is going
+#define OUTPUT_DRAIN_BUDGET_MS 12 // Time a drain may spend copying output each interval
+
+// C compiler used by File > Build Executable. The Makefile passes its $(CC).
+#ifndef BF_CC
+#define BF_CC "gcc"
+#endif
 
 // Registry Constants
 #define REG_COMPANY_KEY_ANSI "Software\\Talamar Developments"
@@ -127,16 +243,21 @@
 #define REG_VALUE_DEBUG_BASIC_ANSI "DebugBasic"
 #define REG_VALUE_DEBUG_INTERPRETER_ANSI "DebugInterpreter"
 #define REG_VALUE_DEBUG_OUTPUT_ANSI "DebugOutput"
+#define REG_VALUE_ENGINE_ANSI "Engine"
+#define REG_VALUE_PROFILE_ANSI "Profile"
+#define REG_VALUE_LARGE_TAPE_ANSI "LargeTape"
+#define REG_VALUE_CELL_WIDTH_ANSI "CellWidth"
+#define REG_VALUE_STEP_LIMIT_ANSI "StepLimit"
+#define REG_VALUE_TIME_LIMIT_ANSI "TimeLimit"
+#define REG_VALUE_OUTPUT_LIMIT_ANSI "OutputLimit"
+#define REG_VALUE_TRACE_ANSI "Trace"
+#define REG_VALUE_CHECKPOINT_ANSI "CheckpointInterval"
 
 // Global variables
 extern HINSTANCE hInst;
 extern HFONT hMonoFont;
 extern HFONT hLabelFont;
-extern HWND hwndCodeEdit;
-extern HWND hwndInputEdit;
-extern HWND hwndOutputEdit;
-extern HANDLE g_hInterpreterThread;
-extern volatile BOOL g_bInterpreterRunning;
+extern HWND hwndTabControl;
 extern HACCEL hAccelTable;
 
 // Global debug settings flags
@@ -144,47 +265,150 @@ extern volatile BOOL g_bDebugInterpreter;
 extern volatile BOOL g_bDebugOutput;
 extern volatile BOOL g_bDebugBasic;
 
-// --- Brainfuck Tape Structure ---
+// Global interpreter settings
+extern volatile int g_nEngine;
+extern volatile BOOL g_bProfile;
+extern volatile BOOL g_bLargeTape; // TAPE_LARGE instead of the 65536-cell wrap-around tape
+extern volatile int g_nCellWidth; // CELL_8BIT, CELL_16BIT or CELL_32BIT
+// Run limits, 0 for none. See Machine.step_limit and friends.
+extern volatile DWORD g_dwStepLimit;   // Millions of instructions
+extern volatile DWORD g_dwTimeLimit;   // Seconds
+extern volatile DWORD g_dwOutputLimit; // Megabytes
+extern volatile BOOL g_bTrace; // Record the last TRACE_RECORDS steps of each run to a file
+extern volatile DWORD g_dwCheckpointInterval; // Minutes between automatic checkpoints, 0 for none
+
+// A file read through a sliding read-only mapping, so the , instruction reads
+// straight from the page cache and files of any size fit in the address space.
+typedef struct {
+    HANDLE hFile;
+    HANDLE hMapping;   // NULL for an empty file, which cannot be mapped
+    ULONGLONG size;
+    ULONGLONG offset;  // File offset of the next view
+    const char* view;  // Currently mapped view, or NULL
+} InputFile;
+
+// A program source file mapped whole and read-only, so it can be compiled
+// without a copy.
+typedef struct {
+    HANDLE hFile;
+    HANDLE hMapping;
+    const char* data; // NULL for an empty file
+    size_t length;
+} SourceFile;
+
+// Single-producer, single-consumer queue carrying program output from the
+// interpreter thread to the UI thread. See WriteOutputRing in bf.c.
 typedef struct {
-    unsigned char tape[TAPE_SIZE];
-    int position;
-} Tape;
+    char* data;                     // OUTPUT_RING_SIZE bytes
+    volatile LONG head;             // Bytes written, advanced by the interpreter thread
+    volatile LONG tail;             // Bytes read, advanced by the UI thread
+} OutputRing;
+
+// One tab of the main window: its own editors, output, bound files and run.
+// Everything belongs to the UI thread except bRunning, which the session's
+// interpreter thread polls, outputRing, which it fills, and the pending
+// analysis request, which the analysis thread takes under its lock.
+typedef struct Session {
+    int number;                   // Shown in the tab label
+    HWND hwndCodeEdit;
+    HWND hwndInputEdit;
+    HWND hwndOutputEdit;
+    char szInputFile[MAX_PATH];   // File bound to standard input, or "" for the input box
+    char szProgramFile[MAX_PATH]; // File run instead of the editor text, or ""
+    char szResumeFile[MAX_PATH];  // Checkpoint the next run resumes from, or ""
+    char szCheckpointFile[MAX_PATH]; // Where a paused run saves its checkpoint, or ""
+    char szCodeError[MAX_STRING_LENGTH]; // Code label for the last problem analysis found, or ""
+    unsigned int analysisSequence; // Of the latest analysis requested, see RequestAnalysis
+    char* pendingCode;            // Text queued for analysis and not yet taken, or NULL
+    size_t pendingLength;
+    unsigned int pendingSequence;
+    struct Session* pNextPending; // Next session in the analysis queue
+    OutputRing outputRing;
+    volatile BOOL bRunning;       // Cleared to stop this session's run only
+    BOOL bBusy;                   // An interpreter thread is running for the session
+    int lastStatus;               // Status of the last finished run, BF_OK before any
+    volatile BOOL bClosed;        // Tab closed while busy; freed when the run ends
+} Session;
+
+extern Session* g_pActiveSession; // Session of the selected tab
 
 // --- Interpreter Parameters Structure ---
 typedef struct {
     HWND hwndMainWindow;
+    Session* session;
     char* code;
+    char* code_path; // Set instead of code when running the session's szProgramFile
     char* input;
     int input_len;
-    int input_pos;
+    char* input_path; // Set instead of input when standard input is a file
+    InputFile input_file;
+    char resume_path[MAX_PATH]; // Checkpoint to resume from, or ""
+    char checkpoint_path[MAX_PATH]; // Automatic checkpoint file, or ""
     char* output_buffer;
-    int output_buffer_pos;
+    Machine machine; // Tape and I/O state used by the engine
 } InterpreterParams;
 
+// Result of analyzing a session's code in the background.
+typedef struct {
+    unsigned int sequence; // Session.analysisSequence of the request
+    int status;            // BF_OK, BF_ERR_MISMATCHED_BRACKETS or BF_ERR_NO_MEMORY
+    char bracket;          // The unmatched bracket, with its position
+    unsigned int line;
+    unsigned int column;
+} AnalysisResult;
+
+// Result of a profiled run, posted to the UI thread when the program ends.
+typedef struct {
+    Session* session; // Session whose code was profiled
+    unsigned long long total; // Instructions executed by the whole program
+    size_t count;
+    LoopProfile loops[PROFILE_TOP_LOOPS];
+} ProfileReport;
+
 // Function Prototypes
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 LRESULT CALLBACK SettingsDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 LRESULT CALLBACK AboutDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+LRESULT CALLBACK ProfileDlgProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
 void DebugPrint(const char* format, ...);
 void DebugPrintInterpreter(const char* format, ...);
 void DebugPrintOutput(const char* format, ...);
-void AppendTextToEditControl(HWND hwndEdit, const char* newText); 
+void AppendOutputText(HWND hwndView, const char* text);
 char* LoadStringFromResource(UINT uID, char* buffer, int bufferSize); 
 
-void Tape_init(Tape* tape);
-unsigned char Tape_get(Tape* tape);
-void Tape_set(Tape* tape, unsigned char value);
-void Tape_inc(Tape* tape);
-void Tape_dec(Tape* tape);
-void Tape_forward(Tape* tape);
-void Tape_reverse(Tape* tape);
-
-char* optimize_code(const char* code);
 DWORD WINAPI InterpretThreadProc(LPVOID lpParam);
-void SendBufferedOutput(InterpreterParams* params);
+void SendBufferedOutput(void* context, const char* data, size_t length);
+LRESULT CALLBACK OutputViewProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+BOOL RegisterOutputViewClass(HINSTANCE hInstance);
+void InitProgramCache(void);
+const Program* AcquireCachedProgram(const char* code, size_t length, int tape_mode, int cell_width, const ProgramPrefix** prefix, int* status);
+void ReleaseCachedProgram(const Program* program);
+BOOL StartAnalysisWorker(HWND hwnd);
+void RequestAnalysis(Session* session);
+void CancelAnalysis(Session* session);
+BOOL OpenSourceFile(SourceFile* file, const char* path);
+void CloseSourceFile(SourceFile* file);
+BOOL BindProgramFile(HWND hwnd, const char* path);
+void UpdateProgramBinding(HWND hwnd);
+BOOL OpenInputFile(InputFile* file, const char* path);
+size_t MapNextInputView(void* context, const char** data);
+void CloseInputFile(InputFile* file);
+void UpdateInputBinding(HWND hwnd);
+BOOL InitOutputRing(OutputRing* ring);
+void ResetOutputRing(OutputRing* ring);
+void DrainOutputRing(OutputRing* ring, HWND hwndView, DWORD budgetMs);
+Session* CreateSession(HWND hwnd);
+void DestroySession(Session* session);
+void SelectSession(HWND hwnd, Session* session);
+BOOL CloseSession(HWND hwnd, Session* session);
+void UpdateSessionTab(Session* session);
+char* GetEditText(HWND hwndEdit, int* length);
+BOOL CompileEditorCode(HWND hwnd, Program* program);
+BOOL ExportProgramToC(const Program* program, const char* path);
+BOOL BuildExecutable(const Program* program, const char* exePath, DWORD* exitCode);
 
-void SaveDebugSettingsToRegistry(void);
-void LoadDebugSettingsFromRegistry(void);
+void SaveSettingsToRegistry(void);
+void LoadSettingsFromRegistry(void);
 
 #endif // BF_H
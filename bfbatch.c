@@ -0,0 +1,508 @@
+// Define to enable POSIX features like sysconf. Must be before any system headers.
+#define _POSIX_C_SOURCE 200809L
+
+#include "bfcli.h"
+#include "bfengine.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Batch runner: runs every (program, input) job listed in a manifest on a
+// pool of worker threads and prints one JSON object per job with its exit
+// status, output size, output checksum and time, then a summary line.
+//
+// Manifest lines are "program input [checksum]", with paths relative to the
+// manifest, "-" for no input and the optional checksum being the 64-bit
+// FNV-1a hash of the expected output. Lines starting with '#' are ignored.
+//
+// Jobs are dealt round-robin to per-worker queues. A worker takes its own
+// jobs from the back and, once its queue is empty, steals from the front of
+// the others, so a worker stuck on a long job does not hold back the short
+// jobs queued behind it.
+
+#define BATCH_OUTPUT_SIZE   (64 * 1024)
+#define MAX_WORKERS         256
+
+// Exit codes
+#define EXIT_ALL_OK         0
+#define EXIT_JOB_FAILED     1
+#define EXIT_USAGE          64
+#define EXIT_NO_INPUT       66
+#define EXIT_SOFTWARE       70
+#define EXIT_INTERRUPTED    130
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION Lock;
+#define Lock_init(lock)     InitializeCriticalSection(lock)
+#define Lock_destroy(lock)  DeleteCriticalSection(lock)
+#define Lock_acquire(lock)  EnterCriticalSection(lock)
+#define Lock_release(lock)  LeaveCriticalSection(lock)
+#else
+typedef pthread_mutex_t Lock;
+#define Lock_init(lock)     pthread_mutex_init(lock, NULL)
+#define Lock_destroy(lock)  pthread_mutex_destroy(lock)
+#define Lock_acquire(lock)  pthread_mutex_lock(lock)
+#define Lock_release(lock)  pthread_mutex_unlock(lock)
+#endif
+
+typedef struct {
+    char program[MAX_FIELD_LENGTH];
+    char input[MAX_FIELD_LENGTH];
+    int hasChecksum;
+    unsigned long long expected;
+    // Filled in by the worker that runs the job
+    const char* status;
+    unsigned long long checksum;
+    unsigned long long bytes;
+    double seconds;
+    int worker;
+} Job;
+
+// A worker's share of the jobs. The owner pops from the back; thieves take
+// from the front, which holds the jobs the owner would reach last.
+typedef struct {
+    Lock lock;
+    int* jobs;
+    int front;
+    int back;
+} JobQueue;
+
+typedef struct {
+    int index;
+    Job* jobs;
+    JobQueue* queues;
+    int workerCount;
+    int engine;
+    int tapeMode;
+    int cellWidth;
+    unsigned long long stepLimit;
+    unsigned long long outputLimit;
+    unsigned int timeLimitMs;
+    const char* outputDir;
+    int steals;
+} Worker;
+
+static const char* g_engineNames[ENGINE_COUNT] = { "switch", "threaded", "jit" };
+
+// Shared by every machine, so Ctrl+C stops all running jobs at once.
+static volatile int g_running = 1;
+
+void DebugPrintInterpreter(const char* format, ...) {
+    (void)format;
+}
+
+static void HandleInterrupt(int signal_number) {
+    (void)signal_number;
+    g_running = 0;
+}
+
+static int ProcessorCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+// Returns the number of jobs read into *jobs, or -1 if the manifest cannot be
+// read or memory runs out.
+static int LoadManifest(const char* path, Job** jobs) {
+    char line[4 * MAX_FIELD_LENGTH];
+    char program[MAX_FIELD_LENGTH], input[MAX_FIELD_LENGTH], checksum[MAX_FIELD_LENGTH];
+    int count = 0, capacity = 0;
+    FILE* file = fopen(path, "r");
+    *jobs = NULL;
+    if (!file)
+        return -1;
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0')
+            continue;
+        int fields = sscanf(line, "%259s %259s %259s", program, input, checksum);
+        if (fields < 2) {
+            fprintf(stderr, "bfbatch: %s: malformed line: %s", path, line);
+            continue;
+        }
+        if (count == capacity) {
+            int grownCapacity = capacity ? capacity * 2 : 64;
+            Job* grown = (Job*)realloc(*jobs, (size_t)grownCapacity * sizeof(Job));
+            if (!grown) {
+                fclose(file);
+                free(*jobs);
+                *jobs = NULL;
+                return -1;
+            }
+            *jobs = grown;
+            capacity = grownCapacity;
+        }
+        Job* job = &(*jobs)[count];
+        memset(job, 0, sizeof(*job));
+        if (!ResolvePath(job->program, path, program) ||
+            (strcmp(input, "-") != 0 && !ResolvePath(job->input, path, input))) {
+            fprintf(stderr, "bfbatch: %s: malformed line (path too long): %s", path, line);
+            continue;
+        }
+        if (fields == 3 && sscanf(checksum, "%llx", &job->expected) == 1)
+            job->hasChecksum = 1;
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+// Takes the next job for a worker: the back of its own queue, or else the
+// front of the first other queue that still has jobs. Jobs never
+// create jobs, so once every queue is empty the worker is done. After
+// Ctrl+C no more jobs are taken.
+static int NextJob(Worker* worker) {
+    JobQueue* own = &worker->queues[worker->index];
+    int job = -1;
+
+    if (!g_running)
+        return -1;
+
+    Lock_acquire(&own->lock);
+    if (own->back > own->front)
+        job = own->jobs[--own->back];
+    Lock_release(&own->lock);
+    if (job >= 0)
+        return job;
+
+    for (int i = 1; i < worker->workerCount && job < 0; i++) {
+        JobQueue* victim = &worker->queues[(worker->index + i) % worker->workerCount];
+        Lock_acquire(&victim->lock);
+        if (victim->back > victim->front)
+            job = victim->jobs[victim->front++];
+        Lock_release(&victim->lock);
+    }
+    if (job >= 0)
+        worker->steals++;
+    return job;
+}
+
+static const char* StatusName(int status) {
+    switch (status) {
+        case BF_OK: return "ok";
+        case BF_ERR_MISMATCHED_BRACKETS: return "mismatched_brackets";
+        case BF_ERR_NO_MEMORY: return "no_memory";
+        case BF_STOPPED: return "interrupted";
+        case BF_STEP_LIMIT: return "step_limit";
+        case BF_TIME_LIMIT: return "time_limit";
+        case BF_OUTPUT_LIMIT: return "output_limit";
+        default: return "io_error";
+    }
+}
+
+// Compiles and runs one job on the worker's machine and records the result.
+static void RunJob(Worker* worker, Machine* machine, char* outputBuffer, int index) {
+    Job* job = &worker->jobs[index];
+    size_t codeLength, inputLength = 0;
+    char* code = ReadWholeFile(job->program, &codeLength);
+    char* input = job->input[0] ? ReadWholeFile(job->input, &inputLength) : NULL;
+    OutputDigest digest = { FNV_OFFSET_BASIS, 0, NULL, 0 };
+    Program program;
+    int status;
+
+    job->worker = worker->index;
+    if (!code || (job->input[0] && !input)) {
+        job->status = "no_input";
+        free(code);
+        free(input);
+        return;
+    }
+    if (worker->outputDir) {
+        char path[MAX_FIELD_LENGTH + 16];
+        snprintf(path, sizeof(path), "%s/%d.out", worker->outputDir, index + 1);
+        digest.file = fopen(path, "wb");
+        digest.failed = !digest.file;
+    }
+
+    double start = Now();
+    status = Program_compile(&program, code, codeLength);
+    free(code);
+    if (status == BF_OK) {
+        status = Machine_init(machine, worker->tapeMode, worker->cellWidth);
+        if (status == BF_OK) {
+            machine->input = input;
+            machine->input_len = inputLength;
+            machine->output_buffer = outputBuffer;
+            machine->output_buffer_size = BATCH_OUTPUT_SIZE;
+            machine->output_callback = DigestOutput;
+            machine->output_context = &digest;
+            machine->running = &g_running;
+            machine->step_limit = worker->stepLimit;
+            machine->output_limit = worker->outputLimit;
+            machine->time_limit_ms = worker->timeLimitMs;
+            status = Machine_run_engine(machine, &program, worker->engine);
+            Machine_free(machine);
+        }
+        Program_free(&program);
+    }
+    job->seconds = Now() - start;
+    free(input);
+
+    if (digest.file && fclose(digest.file) != 0)
+        digest.failed = 1;
+    job->checksum = digest.checksum;
+    job->bytes = digest.bytes;
+    if (status == BF_OK && digest.failed)
+        status = BF_ERR_IO;
+    job->status = StatusName(status);
+    if (status == BF_OK && job->hasChecksum && job->checksum != job->expected)
+        job->status = "mismatch";
+}
+
+#ifdef _WIN32
+static DWORD WINAPI WorkerThreadProc(LPVOID parameter) {
+#else
+static void* WorkerThreadProc(void* parameter) {
+#endif
+    Worker* worker = (Worker*)parameter;
+    Machine* machine = (Machine*)malloc(sizeof(Machine));
+    char* outputBuffer = (char*)malloc(BATCH_OUTPUT_SIZE);
+    int job;
+
+    while ((job = NextJob(worker)) >= 0) {
+        if (!machine || !outputBuffer) {
+            worker->jobs[job].status = "no_memory";
+            worker->jobs[job].worker = worker->index;
+        } else {
+            RunJob(worker, machine, outputBuffer, job);
+        }
+    }
+    free(machine);
+    free(outputBuffer);
+    return 0;
+}
+
+static void PrintJson(const char* key, const char* value) {
+    printf("\"%s\":\"", key);
+    for (; *value; value++) {
+        if (*value == '"' || *value == '\\')
+            putchar('\\');
+        putchar(*value);
+    }
+    putchar('"');
+}
+
+static int ParseChoice(const char* name, const char* const* choices, int count) {
+    for (int i = 0; i < count; i++)
+        if (strcmp(name, choices[i]) == 0)
+            return i;
+    return -1;
+}
+
+// Parses a nonnegative decimal count into *value. Returns 0 if text is not one.
+static int ParseCount(const char* text, unsigned long long* value) {
+    char* end;
+    if (text[0] < '0' || text[0] > '9')
+        return 0;
+    *value = strtoull(text, &end, 10);
+    return *end == '\0';
+}
+
+static void PrintUsage(FILE* file) {
+    fprintf(file,
+        "Usage: bfbatch [options] MANIFEST\n"
+        "Runs the jobs listed in MANIFEST in parallel and prints one JSON object per\n"
+        "job, in manifest order, followed by a summary.\n"
+        "\n"
+        "Options:\n"
+        "  -j, --jobs N          run N worker threads (default: one per processor)\n"
+        "  -e, --engine NAME     execution engine: switch, threaded or jit (default)\n"
+        "  -t, --tape MODE       wrap (default, 65536 cells) or large\n"
+        "  -w, --cell-width N    cell width in bits: 8 (default), 16 or 32\n"
+        "  -o, --output DIR      also write each job's output to DIR/<line>.out\n"
+        "  --max-steps N         stop each job after about N instructions\n"
+        "  --timeout MS          stop each job after MS milliseconds\n"
+        "  --max-output BYTES    stop each job once it has written BYTES bytes\n"
+        "  -h, --help            show this help\n");
+}
+
+int main(int argc, char** argv) {
+    static const char* const tapeNames[TAPE_MODE_COUNT] = { "wrap", "large" };
+    static const char* const widthNames[CELL_WIDTH_COUNT] = { "8", "16", "32" };
+    int workerCount = 0, engine = ENGINE_JIT, tapeMode = TAPE_WRAP, cellWidth = CELL_8BIT;
+    const char* manifest = NULL;
+    const char* outputDir = NULL;
+    unsigned long long stepLimit = 0, outputLimit = 0, timeLimitMs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-j") == 0 || strcmp(arg, "--jobs") == 0) {
+            if (++i >= argc || (workerCount = atoi(argv[i])) < 1) {
+                fprintf(stderr, "bfbatch: --jobs needs a positive count\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-e") == 0 || strcmp(arg, "--engine") == 0) {
+            if (++i >= argc || (engine = ParseChoice(argv[i], g_engineNames, ENGINE_COUNT)) < 0) {
+                fprintf(stderr, "bfbatch: --engine needs one of switch, threaded, jit\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--tape") == 0) {
+            if (++i >= argc || (tapeMode = ParseChoice(argv[i], tapeNames, TAPE_MODE_COUNT)) < 0) {
+                fprintf(stderr, "bfbatch: --tape needs wrap or large\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-w") == 0 || strcmp(arg, "--cell-width") == 0) {
+            if (++i >= argc || (cellWidth = ParseChoice(argv[i], widthNames, CELL_WIDTH_COUNT)) < 0) {
+                fprintf(stderr, "bfbatch: --cell-width needs 8, 16 or 32\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0) {
+            if (++i >= argc) {
+                fprintf(stderr, "bfbatch: --output needs a directory\n");
+                return EXIT_USAGE;
+            }
+            outputDir = argv[i];
+        } else if (strcmp(arg, "--max-steps") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &stepLimit)) {
+                fprintf(stderr, "bfbatch: --max-steps needs a number of instructions\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--timeout") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &timeLimitMs) || timeLimitMs > 0xFFFFFFFFu) {
+                fprintf(stderr, "bfbatch: --timeout needs a number of milliseconds\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--max-output") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &outputLimit)) {
+                fprintf(stderr, "bfbatch: --max-output needs a number of bytes\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            PrintUsage(stdout);
+            return 0;
+        } else if (arg[0] == '-' || manifest) {
+            fprintf(stderr, "bfbatch: unexpected argument %s\n", arg);
+            PrintUsage(stderr);
+            return EXIT_USAGE;
+        } else {
+            manifest = arg;
+        }
+    }
+    if (!manifest) {
+        PrintUsage(stderr);
+        return EXIT_USAGE;
+    }
+
+    Job* jobs;
+    int count = LoadManifest(manifest, &jobs);
+    if (count < 0) {
+        fprintf(stderr, "bfbatch: cannot read %s\n", manifest);
+        return EXIT_NO_INPUT;
+    }
+    if (workerCount == 0)
+        workerCount = ProcessorCount();
+    if (workerCount > MAX_WORKERS)
+        workerCount = MAX_WORKERS;
+    if (workerCount > count)
+        workerCount = count > 0 ? count : 1;
+
+    JobQueue* queues = (JobQueue*)calloc((size_t)workerCount, sizeof(JobQueue));
+    Worker* workers = (Worker*)calloc((size_t)workerCount, sizeof(Worker));
+    int* slots = (int*)malloc(((size_t)count + 1) * sizeof(int));
+    if (!queues || !workers || !slots) {
+        fprintf(stderr, "bfbatch: out of memory\n");
+        return EXIT_SOFTWARE;
+    }
+
+    // Deal the jobs round-robin, storing each queue's jobs contiguously and
+    // in reverse so its owner starts with the earliest lines.
+    int used = 0;
+    for (int w = 0; w < workerCount; w++) {
+        JobQueue* queue = &queues[w];
+        Lock_init(&queue->lock);
+        queue->jobs = slots + used;
+        for (int j = count - 1; j >= 0; j--)
+            if (j % workerCount == w)
+                queue->jobs[queue->back++] = j;
+        used += queue->back;
+
+        workers[w].index = w;
+        workers[w].jobs = jobs;
+        workers[w].queues = queues;
+        workers[w].workerCount = workerCount;
+        workers[w].engine = engine;
+        workers[w].tapeMode = tapeMode;
+        workers[w].cellWidth = cellWidth;
+        workers[w].stepLimit = stepLimit;
+        workers[w].outputLimit = outputLimit;
+        workers[w].timeLimitMs = (unsigned int)timeLimitMs;
+        workers[w].outputDir = outputDir;
+    }
+
+    signal(SIGINT, HandleInterrupt);
+    double start = Now();
+#ifdef _WIN32
+    HANDLE* threads = (HANDLE*)calloc((size_t)workerCount, sizeof(HANDLE));
+    for (int w = 1; threads && w < workerCount; w++)
+        threads[w] = CreateThread(NULL, 0, WorkerThreadProc, &workers[w], 0, NULL);
+    WorkerThreadProc(&workers[0]);
+    for (int w = 1; threads && w < workerCount; w++) {
+        if (threads[w]) {
+            WaitForSingleObject(threads[w], INFINITE);
+            CloseHandle(threads[w]);
+        }
+    }
+    free(threads);
+#else
+    pthread_t* threads = (pthread_t*)calloc((size_t)workerCount, sizeof(pthread_t));
+    int* started = (int*)calloc((size_t)workerCount, sizeof(int));
+    for (int w = 1; threads && started && w < workerCount; w++)
+        started[w] = pthread_create(&threads[w], NULL, WorkerThreadProc, &workers[w]) == 0;
+    WorkerThreadProc(&workers[0]);
+    for (int w = 1; threads && started && w < workerCount; w++)
+        if (started[w])
+            pthread_join(threads[w], NULL);
+    free(threads);
+    free(started);
+#endif
+    double wall = Now() - start;
+
+    // A thread that failed to start leaves its jobs to be stolen by the
+    // others, so every job has run by now unless the batch was interrupted.
+    int failures = 0, steals = 0;
+    double busy = 0.0;
+    for (int j = 0; j < count; j++) {
+        Job* job = &jobs[j];
+        if (!job->status) {
+            job->status = "interrupted";
+            job->worker = -1;
+        }
+        printf("{\"job\":%d,", j + 1);
+        PrintJson("program", job->program);
+        putchar(',');
+        PrintJson("input", job->input[0] ? job->input : "-");
+        printf(",\"status\":\"%s\",\"seconds\":%.6f,\"output_bytes\":%llu,\"checksum\":\"%016llx\",\"worker\":%d}\n",
+               job->status, job->seconds, job->bytes, job->checksum, job->worker);
+        failures += strcmp(job->status, "ok") != 0;
+        busy += job->seconds;
+    }
+    for (int w = 0; w < workerCount; w++) {
+        steals += workers[w].steals;
+        Lock_destroy(&queues[w].lock);
+    }
+    printf("{\"summary\":{\"jobs\":%d,\"failed\":%d,\"workers\":%d,\"steals\":%d,"
+           "\"wall_seconds\":%.6f,\"job_seconds\":%.6f,\"jobs_per_second\":%.2f}}\n",
+           count, failures, workerCount, steals, wall, busy, wall > 0.0 ? (double)count / wall : 0.0);
+
+    free(slots);
+    free(workers);
+    free(queues);
+    free(jobs);
+    if (!g_running)
+        return EXIT_INTERRUPTED;
+    return failures ? EXIT_JOB_FAILED : EXIT_ALL_OK;
+}
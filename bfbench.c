@@ -0,0 +1,303 @@
+// Define to enable POSIX features like getrusage. Must be before any system headers.
+#define _POSIX_C_SOURCE 200809L
+
+#include "bfcli.h"
+#include "bfengine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Benchmark driver: runs every program listed in a manifest through the
+// execution engines, checks the output against the recorded checksum and
+// prints one JSON object per benchmark and engine.
+//
+// Manifest lines are "name program input checksum", with paths relative to
+// the manifest, "-" for no input and the checksum being the 64-bit FNV-1a
+// hash of the expected output. Lines starting with '#' are ignored.
+
+#define MAX_BENCHMARKS      64
+#define BENCH_OUTPUT_SIZE   (64 * 1024)
+
+typedef struct {
+    char name[MAX_FIELD_LENGTH];
+    char program[MAX_FIELD_LENGTH];
+    char input[MAX_FIELD_LENGTH];
+    unsigned long long checksum;
+} Benchmark;
+
+static const char* g_engineNames[ENGINE_COUNT] = { "switch", "threaded", "jit" };
+
+void DebugPrintInterpreter(const char* format, ...) {
+    (void)format;
+}
+
+// Starts a new peak memory measurement where the OS allows it. Linux resets
+// the high-water mark through clear_refs; elsewhere the peak stays
+// process-wide.
+static void ResetPeakMemory(void) {
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if (file) {
+        fputs("5", file);
+        fclose(file);
+    }
+#endif
+}
+
+// Returns the peak resident set size in KiB, or 0 if it is unavailable.
+static unsigned long long PeakMemoryKB(void) {
+#if defined(_WIN32)
+    // GetProcessMemoryInfo lives in psapi.dll on older systems, so look it up
+    // instead of linking against psapi.
+    typedef struct {
+        DWORD cb;
+        DWORD PageFaultCount;
+        SIZE_T PeakWorkingSetSize;
+        SIZE_T WorkingSetSize;
+        SIZE_T QuotaPeakPagedPoolUsage;
+        SIZE_T QuotaPagedPoolUsage;
+        SIZE_T QuotaPeakNonPagedPoolUsage;
+        SIZE_T QuotaNonPagedPoolUsage;
+        SIZE_T PagefileUsage;
+        SIZE_T PeakPagefileUsage;
+    } MemoryCounters;
+    typedef BOOL (WINAPI *GetProcessMemoryInfoFunc)(HANDLE, MemoryCounters*, DWORD);
+    HMODULE psapi = LoadLibraryA("psapi.dll");
+    GetProcessMemoryInfoFunc getInfo = psapi ? (GetProcessMemoryInfoFunc)(void (*)(void))GetProcAddress(psapi, "GetProcessMemoryInfo") : NULL;
+    MemoryCounters counters;
+    unsigned long long peak = 0;
+    counters.cb = sizeof(counters);
+    if (getInfo && getInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        peak = counters.PeakWorkingSetSize / 1024;
+    if (psapi)
+        FreeLibrary(psapi);
+    return peak;
+#elif defined(__linux__)
+    char line[256];
+    unsigned long long peak = 0;
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file)
+        return 0;
+    while (fgets(line, sizeof(line), file))
+        if (sscanf(line, "VmHWM: %llu", &peak) == 1)
+            break;
+    fclose(file);
+    return peak;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return (unsigned long long)usage.ru_maxrss / 1024;
+#else
+    return (unsigned long long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+static int LoadManifest(const char* path, Benchmark* benchmarks) {
+    char line[4 * MAX_FIELD_LENGTH];
+    char program[MAX_FIELD_LENGTH], input[MAX_FIELD_LENGTH];
+    int count = 0;
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return -1;
+    while (fgets(line, sizeof(line), file) && count < MAX_BENCHMARKS) {
+        Benchmark* benchmark = &benchmarks[count];
+        if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0')
+            continue;
+        if (sscanf(line, "%259s %259s %259s %llx", benchmark->name, program, input, &benchmark->checksum) != 4) {
+            fprintf(stderr, "bfbench: %s: malformed line: %s", path, line);
+            continue;
+        }
+        benchmark->input[0] = '\0';
+        if (!ResolvePath(benchmark->program, path, program) ||
+            (strcmp(input, "-") != 0 && !ResolvePath(benchmark->input, path, input))) {
+            fprintf(stderr, "bfbench: %s: malformed line (path too long): %s", path, line);
+            continue;
+        }
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+static int ParseEngine(const char* name) {
+    for (int engine = 0; engine < ENGINE_COUNT; engine++)
+        if (strcmp(name, g_engineNames[engine]) == 0)
+            return engine;
+    return -1;
+}
+
+// Runs the program once and records its output digest and time.
+static int RunOnce(Machine* machine, const Program* program, int engine, const char* input, size_t inputLength,
+                   char* outputBuffer, OutputDigest* digest, double* seconds) {
+    static volatile int running = 1;
+    double start;
+    int status;
+
+    *seconds = 0.0;
+    status = Machine_init(machine, TAPE_WRAP, CELL_8BIT);
+    if (status != BF_OK)
+        return status;
+    machine->input = input;
+    machine->input_len = inputLength;
+    machine->output_buffer = outputBuffer;
+    machine->output_buffer_size = BENCH_OUTPUT_SIZE;
+    machine->output_callback = DigestOutput;
+    machine->output_context = digest;
+    machine->running = &running;
+    digest->checksum = FNV_OFFSET_BASIS;
+    digest->bytes = 0;
+
+    start = Now();
+    status = Machine_run_engine(machine, program, engine);
+    *seconds = Now() - start;
+    Machine_free(machine);
+    return status;
+}
+
+static void PrintUsage(FILE* file) {
+    fprintf(file,
+        "Usage: bfbench [options] MANIFEST [NAME...]\n"
+        "Runs the benchmarks listed in MANIFEST, or only the named ones, and prints\n"
+        "one JSON object per benchmark and engine.\n"
+        "\n"
+        "Options:\n"
+        "  -e, --engine NAME   time only this engine (repeatable): switch, threaded, jit\n"
+        "  -r, --runs N        time N runs per engine and report the fastest (default: 1)\n"
+        "  -h, --help          show this help\n");
+}
+
+int main(int argc, char** argv) {
+    static Benchmark benchmarks[MAX_BENCHMARKS];
+    int selectedEngines[ENGINE_COUNT] = { 0 };
+    int anyEngine = 0, runs = 1, failures = 0;
+    const char* manifest = NULL;
+    char** names = NULL;
+    int nameCount = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-e") == 0 || strcmp(arg, "--engine") == 0) {
+            int engine = ++i < argc ? ParseEngine(argv[i]) : -1;
+            if (engine < 0) {
+                fprintf(stderr, "bfbench: --engine needs one of switch, threaded, jit\n");
+                return 64;
+            }
+            selectedEngines[engine] = anyEngine = 1;
+        } else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--runs") == 0) {
+            if (++i >= argc || (runs = atoi(argv[i])) < 1) {
+                fprintf(stderr, "bfbench: --runs needs a positive count\n");
+                return 64;
+            }
+        } else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            PrintUsage(stdout);
+            return 0;
+        } else if (arg[0] == '-') {
+            fprintf(stderr, "bfbench: unknown option %s\n", arg);
+            PrintUsage(stderr);
+            return 64;
+        } else if (!manifest) {
+            manifest = arg;
+        } else {
+            names = &argv[i];
+            nameCount = argc - i;
+            break;
+        }
+    }
+    if (!manifest) {
+        PrintUsage(stderr);
+        return 64;
+    }
+    if (!anyEngine)
+        for (int engine = 0; engine < ENGINE_COUNT; engine++)
+            selectedEngines[engine] = 1;
+
+    int count = LoadManifest(manifest, benchmarks);
+    if (count < 0) {
+        fprintf(stderr, "bfbench: cannot read %s\n", manifest);
+        return 66;
+    }
+
+    Machine* machine = (Machine*)malloc(sizeof(Machine));
+    char* outputBuffer = (char*)malloc(BENCH_OUTPUT_SIZE);
+    if (!machine || !outputBuffer) {
+        fprintf(stderr, "bfbench: out of memory\n");
+        return 70;
+    }
+
+    for (int b = 0; b < count; b++) {
+        const Benchmark* benchmark = &benchmarks[b];
+        int selected = nameCount == 0;
+        for (int n = 0; n < nameCount; n++)
+            selected |= strcmp(names[n], benchmark->name) == 0;
+        if (!selected)
+            continue;
+
+        size_t codeLength, inputLength = 0;
+        char* code = ReadWholeFile(benchmark->program, &codeLength);
+        char* input = benchmark->input[0] ? ReadWholeFile(benchmark->input, &inputLength) : NULL;
+        Program program;
+        if (!code || (benchmark->input[0] && !input) || Program_compile(&program, code, codeLength) != BF_OK) {
+            fprintf(stderr, "bfbench: %s: cannot load program or input\n", benchmark->name);
+            printf("{\"benchmark\":\"%s\",\"status\":\"error\"}\n", benchmark->name);
+            free(code);
+            free(input);
+            failures++;
+            continue;
+        }
+        free(code);
+
+        // The reference engine is the only one that counts instructions, so
+        // it always runs first; its timing is reported if it was selected.
+        unsigned long long instructions = 0;
+        for (int engine = 0; engine < ENGINE_COUNT; engine++) {
+            if (engine != ENGINE_SWITCH && !selectedEngines[engine])
+                continue;
+            double best = 0.0;
+            unsigned long long peakKB = 0;
+            OutputDigest digest = { FNV_OFFSET_BASIS, 0, NULL, 0 };
+            int status = BF_OK;
+            int engineRuns = selectedEngines[engine] ? runs : 1;
+            for (int run = 0; run < engineRuns && status == BF_OK; run++) {
+                double seconds;
+                ResetPeakMemory();
+                status = RunOnce(machine, &program, engine, input, inputLength, outputBuffer, &digest, &seconds);
+                unsigned long long peak = PeakMemoryKB();
+                if (run == 0 || seconds < best)
+                    best = seconds;
+                if (peak > peakKB)
+                    peakKB = peak;
+            }
+            if (engine == ENGINE_SWITCH)
+                instructions = machine->steps;
+            if (!selectedEngines[engine])
+                continue;
+
+            int ok = status == BF_OK && digest.checksum == benchmark->checksum;
+            failures += !ok;
+            printf("{\"benchmark\":\"%s\",\"engine\":\"%s\",\"status\":\"%s\",\"instructions\":%llu,"
+                   "\"seconds\":%.6f,\"ns_per_instruction\":%.3f,\"output_bytes\":%llu,"
+                   "\"output_mb_per_s\":%.3f,\"peak_memory_kb\":%llu,\"checksum\":\"%016llx\"}\n",
+                   benchmark->name, g_engineNames[engine], ok ? "ok" : "mismatch", instructions,
+                   best, instructions && best > 0.0 ? best * 1e9 / (double)instructions : 0.0,
+                   digest.bytes, best > 0.0 ? (double)digest.bytes / (best * 1e6) : 0.0,
+                   peakKB, digest.checksum);
+            fflush(stdout);
+        }
+        Program_free(&program);
+        free(input);
+    }
+
+    free(machine);
+    free(outputBuffer);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,373 @@
+#include "bf.h"
+
+// --- Compiled Program Cache ---
+// Runs of a program that has not changed since it was last compiled reuse its
+// bytecode, and the state after its input-independent prefix, instead of
+// working them out again. Entries are keyed by an FNV-1a hash and the length
+// of the source text, which tells edited programs apart for all practical
+// purposes, and by the tape mode and cell width the prefix is evaluated
+// with. The prefix is only evaluated when a run first asks for it, so the
+// background analysis compiles without running anything. Any number of
+// threads may hold the same entry; the least recently used entries nobody
+// holds are freed once there are more than PROGRAM_CACHE_SIZE of them or
+// their bytecode and prefix state exceed PROGRAM_CACHE_BYTES. A program
+// compiled while every slot is held is handed out uncached and freed on
+// release.
+
+// Program comes first, so the Program* handed out is also the CompiledProgram*.
+typedef struct {
+    Program program;
+    ProgramPrefix prefix;
+    BOOL bEvaluated;        // prefix was evaluated, or attempted
+    BOOL bPrefix;           // prefix was evaluated and gets runs somewhere
+} CompiledProgram;
+
+typedef struct {
+    unsigned long long hash;
+    size_t source_length;
+    int tape_mode;
+    int cell_width;
+    CompiledProgram* program; // NULL for a free slot
+    size_t bytes;           // Memory the entry counts towards g_cacheBytes
+    unsigned long long used; // g_cacheClock at the last acquire
+    int holders;            // Threads using the program
+} ProgramCacheEntry;
+
+static ProgramCacheEntry g_cache[PROGRAM_CACHE_SIZE];
+static unsigned long long g_cacheClock = 0;
+static size_t g_cacheBytes = 0; // Total bytes of the cached entries
+static CRITICAL_SECTION g_cacheLock;
+
+void InitProgramCache(void) {
+    InitializeCriticalSection(&g_cacheLock);
+}
+
+static unsigned long long HashSource(const char* code, size_t length) {
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)code[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static ProgramCacheEntry* FindCachedProgram(unsigned long long hash, size_t length, int tape_mode, int cell_width) {
+    for (int i = 0; i < PROGRAM_CACHE_SIZE; i++)
+        if (g_cache[i].program && g_cache[i].hash == hash && g_cache[i].source_length == length &&
+            g_cache[i].tape_mode == tape_mode && g_cache[i].cell_width == cell_width)
+            return &g_cache[i];
+    return NULL;
+}
+
+// Memory held by the bytecode, its source map and the prefix's tape blocks
+// and output.
+static size_t CompiledProgramBytes(const CompiledProgram* compiled) {
+    const ProgramPrefix* prefix = &compiled->prefix;
+    return compiled->program.length * (sizeof(Instruction) + sizeof(size_t)) +
+           prefix->block_count * (PREFIX_BLOCK_SIZE + sizeof(size_t)) + prefix->output_length;
+}
+
+static void FreeCompiledProgram(CompiledProgram* compiled) {
+    Program_free(&compiled->program);
+    ProgramPrefix_free(&compiled->prefix);
+    free(compiled);
+}
+
+static void FreeCacheEntry(ProgramCacheEntry* entry) {
+    g_cacheBytes -= entry->bytes;
+    FreeCompiledProgram(entry->program);
+    entry->program = NULL;
+}
+
+// Frees unheld entries, oldest first, until the cache is back within
+// PROGRAM_CACHE_BYTES. Called with the lock held.
+static void TrimProgramCache(void) {
+    while (g_cacheBytes > PROGRAM_CACHE_BYTES) {
+        ProgramCacheEntry* oldest = NULL;
+        for (int i = 0; i < PROGRAM_CACHE_SIZE; i++)
+            if (g_cache[i].program && g_cache[i].holders == 0 && (!oldest || g_cache[i].used < oldest->used))
+                oldest = &g_cache[i];
+        if (!oldest)
+            return;
+        FreeCacheEntry(oldest);
+    }
+}
+
+// Evaluates the program's prefix into compiled, which no other thread may
+// be reading. A prefix that cannot be evaluated is simply not used.
+static void EvaluatePrefix(CompiledProgram* compiled, int tape_mode, int cell_width) {
+    if (Program_evaluate_prefix(&compiled->program, tape_mode, cell_width, PREFIX_STEP_BUDGET, &compiled->prefix) == BF_OK)
+        compiled->bPrefix = compiled->prefix.pc != 0;
+    compiled->bEvaluated = TRUE;
+    DebugPrintInterpreter("AcquireCachedProgram: Evaluated %.0f instructions ahead, to instruction %zu.\n", (double)compiled->prefix.steps, compiled->prefix.pc);
+}
+
+// Gives a cached entry held by this thread the prefix it was acquired
+// without. The prefix is evaluated outside the lock into a copy, since other
+// holders may be running the program, and installed unless another thread
+// got there first; holders only look at it through the pointer handed out
+// below, so installing it under the lock is safe.
+static void EvaluateCachedPrefix(ProgramCacheEntry* entry, int tape_mode, int cell_width) {
+    CompiledProgram evaluated = {0};
+    evaluated.program = entry->program->program;
+    EvaluatePrefix(&evaluated, tape_mode, cell_width);
+
+    EnterCriticalSection(&g_cacheLock);
+    CompiledProgram* compiled = entry->program;
+    if (compiled->bEvaluated) {
+        LeaveCriticalSection(&g_cacheLock);
+        ProgramPrefix_free(&evaluated.prefix);
+        return;
+    }
+    compiled->prefix = evaluated.prefix;
+    compiled->bPrefix = evaluated.bPrefix;
+    compiled->bEvaluated = TRUE;
+    g_cacheBytes -= entry->bytes;
+    entry->bytes = CompiledProgramBytes(compiled);
+    g_cacheBytes += entry->bytes;
+    LeaveCriticalSection(&g_cacheLock);
+}
+
+// Returns the compiled form of code, compiling it if it is not cached, or
+// NULL with *status set to the Program_compile error. If prefix is not NULL,
+// *prefix is set to the state of a fresh run on the given tape after the
+// program's input-independent prefix, or NULL if there is none; callers
+// that only compile pass NULL and nothing is evaluated. Each program
+// returned must be handed back to ReleaseCachedProgram once the run is over.
+const Program* AcquireCachedProgram(const char* code, size_t length, int tape_mode, int cell_width, const ProgramPrefix** prefix, int* status) {
+    unsigned long long hash = HashSource(code, length);
+
+    EnterCriticalSection(&g_cacheLock);
+    ProgramCacheEntry* entry = FindCachedProgram(hash, length, tape_mode, cell_width);
+    if (entry) {
+        entry->used = ++g_cacheClock;
+        entry->holders++;
+        BOOL bEvaluated = entry->program->bEvaluated;
+        LeaveCriticalSection(&g_cacheLock);
+        DebugPrintInterpreter("AcquireCachedProgram: Reusing %zu instructions.\n", entry->program->program.length);
+        // The entry cannot be freed or reused while this thread holds it.
+        if (prefix && !bEvaluated)
+            EvaluateCachedPrefix(entry, tape_mode, cell_width);
+        if (prefix)
+            *prefix = entry->program->bPrefix ? &entry->program->prefix : NULL;
+        *status = BF_OK;
+        return &entry->program->program;
+    }
+    LeaveCriticalSection(&g_cacheLock);
+
+    // Compiled and evaluated outside the lock, so a long compile holds up no
+    // other run.
+    CompiledProgram* compiled = (CompiledProgram*)calloc(1, sizeof(CompiledProgram));
+    if (!compiled) {
+        *status = BF_ERR_NO_MEMORY;
+        return NULL;
+    }
+    *status = Program_compile(&compiled->program, code, length);
+    if (*status != BF_OK) {
+        free(compiled);
+        return NULL;
+    }
+    if (prefix)
+        EvaluatePrefix(compiled, tape_mode, cell_width);
+
+    EnterCriticalSection(&g_cacheLock);
+    entry = FindCachedProgram(hash, length, tape_mode, cell_width);
+    if (entry) {
+        // Another thread compiled the same source meanwhile. Its entry takes
+        // this thread's prefix if it has none yet; no holder can be reading
+        // one that was never evaluated.
+        if (compiled->bEvaluated && !entry->program->bEvaluated) {
+            entry->program->prefix = compiled->prefix;
+            entry->program->bPrefix = compiled->bPrefix;
+            entry->program->bEvaluated = TRUE;
+            memset(&compiled->prefix, 0, sizeof(compiled->prefix));
+            g_cacheBytes -= entry->bytes;
+            entry->bytes = CompiledProgramBytes(entry->program);
+            g_cacheBytes += entry->bytes;
+        }
+        FreeCompiledProgram(compiled);
+    } else {
+        // Take a free slot, or else the least recently used unheld one.
+        for (int i = 0; i < PROGRAM_CACHE_SIZE; i++) {
+            if (!g_cache[i].program) {
+                entry = &g_cache[i];
+                break;
+            }
+            if (g_cache[i].holders == 0 && (!entry || g_cache[i].used < entry->used))
+                entry = &g_cache[i];
+        }
+        if (!entry) {
+            LeaveCriticalSection(&g_cacheLock);
+            if (prefix)
+                *prefix = compiled->bPrefix ? &compiled->prefix : NULL;
+            return &compiled->program;
+        }
+        if (entry->program)
+            FreeCacheEntry(entry);
+        entry->hash = hash;
+        entry->source_length = length;
+        entry->tape_mode = tape_mode;
+        entry->cell_width = cell_width;
+        entry->program = compiled;
+        entry->bytes = CompiledProgramBytes(compiled);
+        entry->holders = 0;
+        g_cacheBytes += entry->bytes;
+    }
+    entry->used = ++g_cacheClock;
+    entry->holders++;
+    compiled = entry->program;
+    LeaveCriticalSection(&g_cacheLock);
+    if (prefix)
+        *prefix = compiled->bPrefix ? &compiled->prefix : NULL;
+    return &compiled->program;
+}
+
+void ReleaseCachedProgram(const Program* program) {
+    EnterCriticalSection(&g_cacheLock);
+    for (int i = 0; i < PROGRAM_CACHE_SIZE; i++) {
+        if (g_cache[i].program && &g_cache[i].program->program == program) {
+            g_cache[i].holders--;
+            TrimProgramCache();
+            LeaveCriticalSection(&g_cacheLock);
+            return;
+        }
+    }
+    LeaveCriticalSection(&g_cacheLock);
+    FreeCompiledProgram((CompiledProgram*)program);
+}
+
+// --- Background Analysis ---
+// A session's code is checked and compiled on a low-priority thread shortly
+// after the user stops typing, so mismatched brackets show in the code label
+// before anything runs and Run finds the program already in the cache.
+// Sessions with a request wait in a queue, oldest first, and each keeps only
+// its latest text: an edit made before the worker takes the request
+// replaces the text in place. Unchanged text is a cache hit.
+
+static CRITICAL_SECTION g_analysisLock;
+static HANDLE g_hAnalysisEvent = NULL;   // Set when a request is queued
+static HWND g_hwndAnalysisOwner;         // Receives WM_APP_ANALYSIS_DONE
+static Session* g_pendingHead = NULL;    // Sessions with a request not yet taken
+static Session* g_pendingTail = NULL;
+static unsigned int g_analysisSequence = 0; // Last sequence number handed out
+
+// Removes the session from the queue. Called with the lock held.
+static void UnlinkPendingSession(Session* session) {
+    Session** link = &g_pendingHead;
+    Session* previous = NULL;
+    while (*link && *link != session) {
+        previous = *link;
+        link = &previous->pNextPending;
+    }
+    if (!*link)
+        return;
+    *link = session->pNextPending;
+    if (g_pendingTail == session)
+        g_pendingTail = previous;
+    session->pNextPending = NULL;
+}
+
+static DWORD WINAPI AnalysisThreadProc(LPVOID lpParam) {
+    (void)lpParam;
+    for (;;) {
+        EnterCriticalSection(&g_analysisLock);
+        Session* session = g_pendingHead;
+        char* code = NULL;
+        size_t length = 0;
+        unsigned int sequence = 0;
+        if (session) {
+            code = session->pendingCode;
+            length = session->pendingLength;
+            sequence = session->pendingSequence;
+            session->pendingCode = NULL;
+            UnlinkPendingSession(session);
+        }
+        LeaveCriticalSection(&g_analysisLock);
+        if (!code) {
+            WaitForSingleObject(g_hAnalysisEvent, INFINITE);
+            continue;
+        }
+
+        AnalysisResult* result = (AnalysisResult*)malloc(sizeof(AnalysisResult));
+        if (result) {
+            size_t offset = 0;
+            result->sequence = sequence;
+            result->status = Program_check_brackets(code, length, &offset);
+            if (result->status == BF_OK) {
+                const Program* program = AcquireCachedProgram(code, length, g_bLargeTape ? TAPE_LARGE : TAPE_WRAP, g_nCellWidth, NULL, &result->status);
+                if (program)
+                    ReleaseCachedProgram(program);
+            } else {
+                // Lines and columns count from 1.
+                result->bracket = code[offset];
+                result->line = 1;
+                result->column = 1;
+                for (size_t i = 0; i < offset; i++) {
+                    if (code[i] == '\n') {
+                        result->line++;
+                        result->column = 1;
+                    } else if (code[i] != '\r')
+                        result->column++;
+                }
+            }
+            PostMessage(g_hwndAnalysisOwner, WM_APP_ANALYSIS_DONE, (WPARAM)session, (LPARAM)result);
+        }
+        free(code);
+    }
+    return 0;
+}
+
+// Starts the analysis thread, reporting to hwnd. Without it, sessions are
+// simply not analyzed.
+BOOL StartAnalysisWorker(HWND hwnd) {
+    InitializeCriticalSection(&g_analysisLock);
+    g_hwndAnalysisOwner = hwnd;
+    g_hAnalysisEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+    if (!g_hAnalysisEvent)
+        return FALSE;
+    HANDLE hThread = CreateThread(NULL, 0, AnalysisThreadProc, NULL, 0, NULL);
+    if (!hThread) {
+        CloseHandle(g_hAnalysisEvent);
+        g_hAnalysisEvent = NULL;
+        return FALSE;
+    }
+    SetThreadPriority(hThread, THREAD_PRIORITY_LOWEST);
+    CloseHandle(hThread);
+    return TRUE;
+}
+
+// Queues the session's editor text for analysis. Sessions bound to a program
+// file are compiled from the file when they run, so they are skipped.
+void RequestAnalysis(Session* session) {
+    int length;
+    if (!g_hAnalysisEvent || session->szProgramFile[0] != '\0')
+        return;
+    char* code = GetEditText(session->hwndCodeEdit, &length);
+    if (!code)
+        return;
+    EnterCriticalSection(&g_analysisLock);
+    if (session->pendingCode)
+        free(session->pendingCode);
+    else if (g_pendingTail)
+        g_pendingTail = g_pendingTail->pNextPending = session;
+    else
+        g_pendingHead = g_pendingTail = session;
+    session->pendingCode = code;
+    session->pendingLength = (size_t)length;
+    session->pendingSequence = session->analysisSequence = ++g_analysisSequence;
+    LeaveCriticalSection(&g_analysisLock);
+    SetEvent(g_hAnalysisEvent);
+}
+
+// Drops the session's queued request, if any, before the session is freed.
+// A request the worker has already taken only comes back as a message, which
+// is ignored once the session has no tab.
+void CancelAnalysis(Session* session) {
+    if (!g_hAnalysisEvent)
+        return;
+    EnterCriticalSection(&g_analysisLock);
+    free(session->pendingCode);
+    session->pendingCode = NULL;
+    UnlinkPendingSession(session);
+    LeaveCriticalSection(&g_analysisLock);
+}
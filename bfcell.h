@@ -0,0 +1,266 @@
+// Width-specialized engine loops. bfengine.c includes this file once per
+// cell width, with CELL_TYPE set to the cell's C type and CELL_NAME(name)
+// appending the width to a function name. Every load and store of a cell is
+// written against CELL_TYPE, so each instantiation compiles to fixed-size
+// accesses and neither loop tests the width. There is deliberately no
+// include guard.
+
+// Reference interpreter: one instruction per iteration, with step counting
+// and the optional per-instruction profile counts. Every access wraps its
+// offset, which is zero outside folded loops. Stops and limits are polled on
+// back-edges exactly as in the threaded engine, so every engine stops a
+// given program at the same point. The run starts at machine->pc and leaves
+// there the instruction to resume at. traced is a constant at both call sites,
+// so the untraced copy has no trace code at all; the traced copy appends a
+// record to machine->trace before each instruction.
+static BF_INLINE int CELL_NAME(Machine_run_loop)(Machine* machine, const Program* program, const int traced) {
+    CELL_TYPE* cells = (CELL_TYPE*)machine->tape.tape;
+    const unsigned int mask = machine->tape.mask;
+    unsigned int pos = (unsigned int)machine->tape.position;
+    const Instruction* code = program->code;
+    size_t pc = machine->pc;
+    int poll = POLL_QUANTUM;
+    int status = BF_OK;
+    TraceRecord* const records = traced ? machine->trace->records : NULL;
+    const size_t trace_mask = traced ? machine->trace->capacity - 1 : 0;
+    unsigned long long trace_count = traced ? machine->trace->count : 0;
+
+    while (pc < program->length && status == BF_OK) {
+        const Instruction* ins = &code[pc];
+        if (traced) {
+            TraceRecord* record = &records[trace_count++ & trace_mask];
+            record->pc = (unsigned int)pc;
+            record->op = (unsigned int)ins->op;
+            record->position = pos;
+            record->cell = (unsigned int)cells[pos];
+        }
+        machine->steps++;
+        if (machine->counts)
+            machine->counts[pc]++;
+
+        switch (ins->op) {
+            case OP_ADD: cells[(pos + (unsigned int)ins->offset) & mask] += (CELL_TYPE)ins->arg; pc++; break;
+            case OP_MOVE: pos = (pos + (unsigned int)ins->arg) & mask; pc++; break;
+            case OP_IN:
+                cells[(pos + (unsigned int)ins->offset) & mask] = (CELL_TYPE)Machine_read_input(machine);
+                pc++;
+                break;
+            case OP_OUT:
+                if (machine->output_buffer_pos == machine->output_buffer_size)
+                    Machine_flush_output(machine);
+                machine->output_buffer[machine->output_buffer_pos++] = (char)cells[(pos + (unsigned int)ins->offset) & mask];
+                pc++;
+                break;
+            case OP_JZ:
+                pc = cells[pos] == 0 ? (size_t)ins->arg : pc + 1;
+                break;
+            case OP_JNZ:
+                if (cells[pos] == 0) {
+                    pc++;
+                    break;
+                }
+                // Each pass round the loop is charged its length in instructions.
+                poll -= (int)(pc + 1 - (size_t)ins->arg);
+                pc = (size_t)ins->arg;
+                if (poll <= 0) {
+                    machine->charged += (unsigned long long)(POLL_QUANTUM - poll);
+                    poll = POLL_QUANTUM;
+                    // A stopped run resumes at the loop's opening bracket,
+                    // where every engine can enter.
+                    if ((status = Machine_poll(machine)) != BF_OK)
+                        pc--;
+                }
+                break;
+            case OP_CLEAR: cells[(pos + (unsigned int)ins->offset) & mask] = 0; pc++; break;
+            case OP_MULADD:
+                cells[(pos + (unsigned int)ins->offset) & mask] += (CELL_TYPE)((unsigned int)cells[pos] * (unsigned int)ins->arg);
+                pc++;
+                break;
+            case OP_SCAN:
+                // A scan that finds no zero cell never ends; stay on it and
+                // charge each lap round the tape a whole quantum so the stop
+                // signal and the limits are still honoured.
+                machine->tape.position = (int)pos;
+                if (Tape_scan(&machine->tape, ins->arg)) {
+                    pos = (unsigned int)machine->tape.position;
+                    pc++;
+                } else {
+                    machine->charged += POLL_QUANTUM;
+                    status = Machine_poll(machine);
+                }
+                break;
+        }
+    }
+    machine->tape.position = (int)pos;
+    machine->pc = pc;
+    if (traced)
+        machine->trace->count = trace_count;
+    Machine_flush_output(machine);
+
+    if (status != BF_OK)
+        DebugPrintInterpreter("Machine_run: Stopped with status %d.\n", status);
+    return status;
+}
+
+static int CELL_NAME(Machine_run)(Machine* machine, const Program* program) {
+    if (machine->trace)
+        return CELL_NAME(Machine_run_loop)(machine, program, 1);
+    return CELL_NAME(Machine_run_loop)(machine, program, 0);
+}
+
+// Executes the program with the head, the cell array and the output cursor
+// held in locals, starting at machine->pc. Each taken back-edge charges its
+// loop's length against a countdown, and the stop signal and limits are only
+// polled when POLL_QUANTUM instructions have been charged. No function is
+// called otherwise except to flush output or scan.
+// Accesses at an offset get their own handlers so the common offset-0 forms
+// do no address arithmetic.
+static int CELL_NAME(Machine_run_threaded)(Machine* machine, const Program* program) {
+    ThreadedInstruction* code = (ThreadedInstruction*)malloc((program->length + 1) * sizeof(ThreadedInstruction));
+    if (!code)
+        return BF_ERR_NO_MEMORY;
+
+#ifdef BF_COMPUTED_GOTO
+    static const void* const handlers[] = {
+        [OP_ADD] = &&label_OP_ADD, [OP_MOVE] = &&label_OP_MOVE,
+        [OP_IN] = &&label_OP_IN, [OP_OUT] = &&label_OP_OUT,
+        [OP_JZ] = &&label_OP_JZ, [OP_JNZ] = &&label_OP_JNZ,
+        [OP_CLEAR] = &&label_OP_CLEAR, [OP_MULADD] = &&label_OP_MULADD,
+        [OP_SCAN] = &&label_OP_SCAN, [OP_END] = &&label_OP_END,
+        [OP_ADD_AT] = &&label_OP_ADD_AT, [OP_IN_AT] = &&label_OP_IN_AT,
+        [OP_OUT_AT] = &&label_OP_OUT_AT, [OP_CLEAR_AT] = &&label_OP_CLEAR_AT
+    };
+#define SET_OP(ins, opcode) ((ins)->handler = handlers[opcode])
+#else
+#define SET_OP(ins, opcode) ((ins)->op = (opcode))
+#endif
+    // OP_JNZ has no cell offset; its offset field holds the loop's length.
+    for (size_t i = 0; i < program->length; i++) {
+        SET_OP(&code[i], Threaded_op(&program->code[i]));
+        code[i].arg = program->code[i].arg;
+        code[i].offset = program->code[i].op == OP_JNZ ? (int)(i + 1 - (size_t)program->code[i].arg) : program->code[i].offset;
+    }
+    SET_OP(&code[program->length], OP_END);
+#undef SET_OP
+
+    CELL_TYPE* cells = (CELL_TYPE*)machine->tape.tape;
+    const unsigned int mask = machine->tape.mask;
+    unsigned int pos = (unsigned int)machine->tape.position;
+    char* out = machine->output_buffer;
+    size_t out_pos = machine->output_buffer_pos;
+    const size_t out_size = machine->output_buffer_size;
+    int poll = POLL_QUANTUM;
+    int status = BF_OK;
+    const ThreadedInstruction* ip = code + machine->pc;
+
+#ifdef BF_COMPUTED_GOTO
+    DISPATCH();
+#else
+dispatch:
+    switch (ip->op) {
+#endif
+    TARGET(OP_ADD)
+        cells[pos] += (CELL_TYPE)ip->arg;
+        ip++;
+        DISPATCH();
+    TARGET(OP_MOVE)
+        pos = (pos + (unsigned int)ip->arg) & mask;
+        ip++;
+        DISPATCH();
+    TARGET(OP_IN)
+        if (machine->input_pos < machine->input_len)
+            cells[pos] = (unsigned char)machine->input[machine->input_pos++];
+        else {
+            machine->output_buffer_pos = out_pos;
+            cells[pos] = (CELL_TYPE)Machine_read_input(machine);
+            out_pos = machine->output_buffer_pos;
+        }
+        ip++;
+        DISPATCH();
+    TARGET(OP_OUT)
+        if (out_pos == out_size) {
+            machine->output_buffer_pos = out_pos;
+            Machine_flush_output(machine);
+            out_pos = machine->output_buffer_pos;
+        }
+        out[out_pos++] = (char)cells[pos];
+        ip++;
+        DISPATCH();
+    TARGET(OP_JZ)
+        ip = cells[pos] == 0 ? code + ip->arg : ip + 1;
+        DISPATCH();
+    TARGET(OP_JNZ)
+        if (cells[pos] == 0) {
+            ip++;
+            DISPATCH();
+        }
+        if ((poll -= ip->offset) <= 0) {
+            machine->charged += (unsigned long long)(POLL_QUANTUM - poll);
+            poll = POLL_QUANTUM;
+            if ((status = Machine_poll(machine)) != BF_OK) {
+                machine->pc = (size_t)ip->arg - 1; // The opening bracket, as in Machine_run
+                goto done;
+            }
+        }
+        ip = code + ip->arg;
+        DISPATCH();
+    TARGET(OP_CLEAR)
+        cells[pos] = 0;
+        ip++;
+        DISPATCH();
+    TARGET(OP_ADD_AT)
+        cells[(pos + (unsigned int)ip->offset) & mask] += (CELL_TYPE)ip->arg;
+        ip++;
+        DISPATCH();
+    TARGET(OP_IN_AT)
+        machine->output_buffer_pos = out_pos;
+        cells[(pos + (unsigned int)ip->offset) & mask] = (CELL_TYPE)Machine_read_input(machine);
+        out_pos = machine->output_buffer_pos;
+        ip++;
+        DISPATCH();
+    TARGET(OP_OUT_AT)
+        if (out_pos == out_size) {
+            machine->output_buffer_pos = out_pos;
+            Machine_flush_output(machine);
+            out_pos = machine->output_buffer_pos;
+        }
+        out[out_pos++] = (char)cells[(pos + (unsigned int)ip->offset) & mask];
+        ip++;
+        DISPATCH();
+    TARGET(OP_CLEAR_AT)
+        cells[(pos + (unsigned int)ip->offset) & mask] = 0;
+        ip++;
+        DISPATCH();
+    TARGET(OP_MULADD)
+        cells[(pos + (unsigned int)ip->offset) & mask] += (CELL_TYPE)((unsigned int)cells[pos] * (unsigned int)ip->arg);
+        ip++;
+        DISPATCH();
+    TARGET(OP_SCAN)
+        machine->tape.position = (int)pos;
+        if (Tape_scan(&machine->tape, ip->arg)) {
+            pos = (unsigned int)machine->tape.position;
+            ip++;
+        } else {
+            machine->charged += POLL_QUANTUM;
+            if ((status = Machine_poll(machine)) != BF_OK) {
+                machine->pc = (size_t)(ip - code);
+                goto done;
+            }
+        }
+        DISPATCH();
+    TARGET(OP_END)
+        machine->pc = program->length;
+        goto done;
+#ifndef BF_COMPUTED_GOTO
+    }
+#endif
+
+done:
+    machine->tape.position = (int)pos;
+    machine->output_buffer_pos = out_pos;
+    Machine_flush_output(machine);
+    free(code);
+    if (status != BF_OK)
+        DebugPrintInterpreter("Machine_run_threaded: Stopped with status %d.\n", status);
+    return status;
+}
@@ -0,0 +1,87 @@
+// Define to enable POSIX features like clock_gettime. Must be before any system headers.
+#define _POSIX_C_SOURCE 200809L
+
+#include "bfcli.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Output callback: folds the output into the digest's checksum and copies it
+// to the digest's file, if any.
+void DigestOutput(void* context, const char* data, size_t length) {
+    OutputDigest* digest = (OutputDigest*)context;
+    unsigned long long hash = digest->checksum;
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char)data[i]) * FNV_PRIME;
+    digest->checksum = hash;
+    digest->bytes += length;
+    if (digest->file && fwrite(data, 1, length, digest->file) != length)
+        digest->failed = 1;
+}
+
+// Seconds from an arbitrary start, for timing runs.
+double Now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Returns the whole file in a malloc'd block, or NULL if it cannot be read.
+char* ReadWholeFile(const char* path, size_t* length) {
+    FILE* file = fopen(path, "rb");
+    size_t capacity = 64 * 1024, used = 0, count;
+    char* data;
+    if (!file)
+        return NULL;
+    data = (char*)malloc(capacity);
+    while (data && (count = fread(data + used, 1, capacity - used, file)) > 0) {
+        used += count;
+        if (used == capacity) {
+            char* grown = (char*)realloc(data, capacity * 2);
+            if (!grown) {
+                free(data);
+                data = NULL;
+                break;
+            }
+            data = grown;
+            capacity *= 2;
+        }
+    }
+    if (data && ferror(file)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *length = used;
+    return data;
+}
+
+// Joins path to the directory part of base into result, MAX_FIELD_LENGTH
+// bytes. Returns 0, leaving result empty, if the joined path does not fit.
+int ResolvePath(char* result, const char* base, const char* path) {
+    const char* slash = strrchr(base, '/');
+    const char* backslash = strrchr(base, '\\');
+    size_t dirLength;
+    if (backslash && (!slash || backslash > slash))
+        slash = backslash;
+    dirLength = slash ? (size_t)(slash - base + 1) : 0;
+    result[0] = '\0';
+    if (dirLength + strlen(path) >= MAX_FIELD_LENGTH)
+        return 0;
+    memcpy(result, base, dirLength);
+    strcpy(result + dirLength, path);
+    return 1;
+}
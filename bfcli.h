@@ -0,0 +1,30 @@
+#ifndef BFCLI_H
+#define BFCLI_H
+
+// Helpers shared by the command-line tools. Like bfengine.h, this file must
+// not depend on windows.h.
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define MAX_FIELD_LENGTH    260 // Longest name or path in a manifest line
+
+// 64-bit FNV-1a, the checksum recorded in manifests
+#define FNV_OFFSET_BASIS    0xcbf29ce484222325ULL
+#define FNV_PRIME           0x100000001b3ULL
+
+// Output callback context for DigestOutput. Start checksum at
+// FNV_OFFSET_BASIS; file is optional.
+typedef struct {
+    unsigned long long checksum;
+    unsigned long long bytes;
+    FILE* file;   // Also receives the output when set
+    int failed;   // Writing to file failed
+} OutputDigest;
+
+void DigestOutput(void* context, const char* data, size_t length);
+double Now(void);
+char* ReadWholeFile(const char* path, size_t* length);
+int ResolvePath(char* result, const char* base, const char* path);
+
+#endif // BFCLI_H
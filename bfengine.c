@@ -0,0 +1,1200 @@
+// MAP_ANONYMOUS is not part of POSIX.1-2008. Must be before any system headers.
+#define _DEFAULT_SOURCE
+
+#include "bfengine.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <time.h>
+#endif
+
+_Static_assert((TAPE_SIZE & (TAPE_SIZE - 1)) == 0, "TAPE_SIZE must be a power of two");
+
+// --- Brainfuck Tape Structure and Functions ---
+#ifdef _WIN32
+// Windows charges committed memory against the commit limit whether it is
+// touched or not, so a large tape is only reserved. Touching a page of it
+// raises an access violation, which Tape_commit_on_fault answers by
+// committing the TAPE_COMMIT_CHUNK around it and retrying the access. The
+// handler only knows the reservations listed in g_tapeReserved, whose
+// entries are claimed through g_tapeSlotUsed and published base last.
+// Vectored handlers arrived with Windows XP; before that, and when every
+// slot is taken, the whole tape is committed up front instead.
+#define TAPE_MAX_RESERVED   64
+#define TAPE_COMMIT_CHUNK   (64 * 1024) // Divides every tape size
+
+typedef PVOID (WINAPI *AddVectoredExceptionHandlerFunc)(ULONG, PVECTORED_EXCEPTION_HANDLER);
+
+static unsigned char* volatile g_tapeReserved[TAPE_MAX_RESERVED];
+static size_t g_tapeReservedSize[TAPE_MAX_RESERVED];
+static volatile LONG g_tapeSlotUsed[TAPE_MAX_RESERVED];
+static volatile LONG g_tapeHandlerState = 0; // 0 not tried, 1 installing, 2 installed, 3 unavailable
+
+// Commits the chunk of a reserved tape an access faulted on. An access
+// outside every tape, or a commit that fails because the system is out of
+// memory, is left to crash the process rather than run on a broken tape.
+static LONG WINAPI Tape_commit_on_fault(EXCEPTION_POINTERS* info) {
+    const EXCEPTION_RECORD* record = info->ExceptionRecord;
+    if (record->ExceptionCode != EXCEPTION_ACCESS_VIOLATION || record->NumberParameters < 2)
+        return EXCEPTION_CONTINUE_SEARCH;
+    unsigned char* address = (unsigned char*)record->ExceptionInformation[1];
+    for (int i = 0; i < TAPE_MAX_RESERVED; i++) {
+        unsigned char* base = g_tapeReserved[i];
+        if (base && address >= base && address < base + g_tapeReservedSize[i]) {
+            size_t offset = (size_t)(address - base) & ~(size_t)(TAPE_COMMIT_CHUNK - 1);
+            if (VirtualAlloc(base + offset, TAPE_COMMIT_CHUNK, MEM_COMMIT, PAGE_READWRITE))
+                return EXCEPTION_CONTINUE_EXECUTION;
+            break;
+        }
+    }
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+// Installs Tape_commit_on_fault once per process. Returns 0 if the system
+// has no vectored exception handlers.
+static int Tape_install_fault_handler(void) {
+    LONG state = InterlockedCompareExchange(&g_tapeHandlerState, 1, 0);
+    if (state == 0) {
+        HMODULE kernel = GetModuleHandleA("kernel32.dll");
+        AddVectoredExceptionHandlerFunc add = kernel ? (AddVectoredExceptionHandlerFunc)(void (*)(void))GetProcAddress(kernel, "AddVectoredExceptionHandler") : NULL;
+        state = add && add(1, Tape_commit_on_fault) ? 2 : 3;
+        InterlockedExchange(&g_tapeHandlerState, state);
+    }
+    while (state == 1) {
+        Sleep(0);
+        state = InterlockedCompareExchange(&g_tapeHandlerState, 1, 1);
+    }
+    return state == 2;
+}
+
+static int Tape_register(unsigned char* memory, size_t size) {
+    for (int i = 0; i < TAPE_MAX_RESERVED; i++) {
+        if (InterlockedCompareExchange(&g_tapeSlotUsed[i], 1, 0) == 0) {
+            g_tapeReservedSize[i] = size;
+            InterlockedExchangePointer((PVOID volatile*)&g_tapeReserved[i], memory);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void Tape_unregister(unsigned char* memory) {
+    for (int i = 0; i < TAPE_MAX_RESERVED; i++) {
+        if (g_tapeReserved[i] == memory) {
+            InterlockedExchangePointer((PVOID volatile*)&g_tapeReserved[i], NULL);
+            InterlockedExchange(&g_tapeSlotUsed[i], 0);
+            return;
+        }
+    }
+}
+#endif
+
+// Maps size bytes of zero-filled memory that is only backed by physical
+// pages once touched.
+static unsigned char* Tape_map(size_t size) {
+#ifdef _WIN32
+    if (Tape_install_fault_handler()) {
+        unsigned char* memory = (unsigned char*)VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+        if (!memory)
+            return NULL;
+        if (Tape_register(memory, size))
+            return memory;
+        VirtualFree(memory, 0, MEM_RELEASE);
+    }
+    return (unsigned char*)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return memory == MAP_FAILED ? NULL : (unsigned char*)memory;
+#endif
+}
+
+static void Tape_unmap(unsigned char* memory, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    Tape_unregister(memory);
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
+
+// Allocates a zeroed tape with the head on cell 0. A large tape is always
+// TAPE_LARGE_SIZE cells, so its wrap-around point, checkpoints and cached
+// prefixes do not depend on memory load; if it cannot be mapped, this fails.
+int Tape_init(Tape* tape, int mode, int cell_width) {
+    size_t size = mode == TAPE_LARGE ? TAPE_LARGE_SIZE : TAPE_SIZE;
+
+    tape->position = 0;
+    tape->cell_width = cell_width;
+    tape->mapped = mode == TAPE_LARGE;
+    if (tape->mapped)
+        tape->tape = Tape_map(size << cell_width);
+    else
+        tape->tape = (unsigned char*)calloc(size, (size_t)1 << cell_width);
+    if (!tape->tape) {
+        DebugPrintInterpreter("Tape_init: Could not allocate %lu cells.\n", (unsigned long)size);
+        return BF_ERR_NO_MEMORY;
+    }
+    tape->mask = (unsigned int)(size - 1);
+    return BF_OK;
+}
+
+void Tape_free(Tape* tape) {
+    if (tape->mapped)
+        Tape_unmap(tape->tape, Tape_size(tape) << tape->cell_width);
+    else
+        free(tape->tape);
+    tape->tape = NULL;
+}
+
+size_t Tape_size(const Tape* tape) {
+    return (size_t)tape->mask + 1;
+}
+
+// The accessors below serve callers outside the engines and check the cell
+// width on every call; the engines themselves are specialized per width.
+static unsigned int Tape_load(const Tape* tape, unsigned int index) {
+    switch (tape->cell_width) {
+        case CELL_16BIT: return ((const uint16_t*)tape->tape)[index];
+        case CELL_32BIT: return ((const uint32_t*)tape->tape)[index];
+        default: return tape->tape[index];
+    }
+}
+
+static void Tape_store(Tape* tape, unsigned int index, unsigned int value) {
+    switch (tape->cell_width) {
+        case CELL_16BIT: ((uint16_t*)tape->tape)[index] = (uint16_t)value; break;
+        case CELL_32BIT: ((uint32_t*)tape->tape)[index] = (uint32_t)value; break;
+        default: tape->tape[index] = (unsigned char)value; break;
+    }
+}
+
+unsigned int Tape_get(Tape* tape) {
+    return Tape_load(tape, (unsigned int)tape->position);
+}
+
+void Tape_set(Tape* tape, unsigned int value) {
+    Tape_store(tape, (unsigned int)tape->position, value);
+}
+
+void Tape_add(Tape* tape, int delta) {
+    Tape_add_at(tape, 0, delta);
+}
+
+// Adds delta to the cell offset cells away from the head, wrapping like Tape_move.
+void Tape_add_at(Tape* tape, int offset, int delta) {
+    unsigned int index = (unsigned int)(tape->position + offset) & tape->mask;
+    Tape_store(tape, index, Tape_load(tape, index) + (unsigned int)delta);
+}
+
+// Moves the head by delta cells, wrapping around at either end of the tape.
+void Tape_move(Tape* tape, int delta) {
+    tape->position = (int)((unsigned int)(tape->position + delta) & tape->mask);
+}
+
+// --- Compiler ---
+static int Program_emit(Program* program, size_t* capacity, int op, int arg, size_t source) {
+    if (program->length == *capacity) {
+        size_t new_capacity = *capacity ? *capacity * 2 : 64;
+        Instruction* code = (Instruction*)realloc(program->code, new_capacity * sizeof(Instruction));
+        if (!code)
+            return BF_ERR_NO_MEMORY;
+        program->code = code;
+        size_t* sources = (size_t*)realloc(program->source, new_capacity * sizeof(size_t));
+        if (!sources)
+            return BF_ERR_NO_MEMORY;
+        program->source = sources;
+        *capacity = new_capacity;
+    }
+    program->code[program->length].op = op;
+    program->code[program->length].arg = arg;
+    program->code[program->length].offset = 0;
+    program->source[program->length] = source;
+    program->length++;
+    return BF_OK;
+}
+
+// Folds a +/- or >/< into the previous instruction when it has the same
+// opcode. Runs that cancel out are dropped entirely.
+static int Program_emit_run(Program* program, size_t* capacity, int op, int delta, size_t source) {
+    if (program->length > 0) {
+        Instruction* last = &program->code[program->length - 1];
+        if (last->op == op && last->arg < MAX_RUN_LENGTH && last->arg > -MAX_RUN_LENGTH) {
+            last->arg += delta;
+            if (last->arg == 0)
+                program->length--;
+            return BF_OK;
+        }
+    }
+    return Program_emit(program, capacity, op, delta, source);
+}
+
+// Replaces the loop starting at index open, which must be the last loop in
+// the program, with a single instruction when it is a scan loop ([>], [<<]),
+// or with straight-line code when it is a clear or multiply loop: a balanced
+// body of ADD/MOVE only that changes the loop cell by exactly 1 per
+// iteration. Returns 1 if the loop was rewritten.
+static int Program_optimize_loop(Program* program, size_t* capacity, size_t open) {
+    int offsets[MAX_IDIOM_LENGTH], deltas[MAX_IDIOM_LENGTH];
+    int targets = 0, offset = 0, step = 0;
+    size_t body_len = program->length - open - 1;
+    size_t source = program->source[open];
+
+    if (body_len == 0 || body_len > MAX_IDIOM_LENGTH)
+        return 0;
+    if (body_len == 1 && program->code[open + 1].op == OP_MOVE &&
+        program->code[open + 1].arg > -TAPE_SIZE && program->code[open + 1].arg < TAPE_SIZE) {
+        int stride = program->code[open + 1].arg;
+        program->length = open;
+        return Program_emit(program, capacity, OP_SCAN, stride, source) == BF_OK ? 1 : -1;
+    }
+    for (size_t i = open + 1; i < program->length; i++) {
+        const Instruction* ins = &program->code[i];
+        if (ins->op == OP_MOVE) {
+            offset += ins->arg;
+            // A multiple of TAPE_SIZE would be the loop cell itself on the
+            // wrap-around tape, so targets stay within one tape length.
+            if (offset <= -TAPE_SIZE || offset >= TAPE_SIZE)
+                return 0;
+        } else if (ins->op != OP_ADD)
+            return 0; // I/O or a nested loop
+        else if (offset == 0)
+            step += ins->arg;
+        else {
+            int t = 0;
+            while (t < targets && offsets[t] != offset)
+                t++;
+            if (t == targets) {
+                offsets[targets] = offset;
+                deltas[targets++] = 0;
+            }
+            deltas[t] += ins->arg;
+        }
+    }
+    if (offset != 0 || (step != 1 && step != -1))
+        return 0;
+
+    // The loop runs -cell times when step is +1 (modulo the cell width), so
+    // the multiplier is negated in that case.
+    program->length = open;
+    for (int t = 0; t < targets; t++) {
+        if (deltas[t] == 0)
+            continue;
+        if (Program_emit(program, capacity, OP_MULADD, step == -1 ? deltas[t] : -deltas[t], source) != BF_OK)
+            return -1;
+        program->code[program->length - 1].offset = offsets[t];
+    }
+    if (Program_emit(program, capacity, OP_CLEAR, 0, source) != BF_OK)
+        return -1;
+    return 1;
+}
+
+// Rewrites the loop starting at index open, which must be the last loop in
+// the program, to address its cells relative to the head at loop entry when
+// its body is ADD, MOVE, IN, OUT and CLEAR only and the moves add up to
+// zero: each access takes the running total of the moves before it as its
+// offset and the moves are dropped. The engines then wrap each access rather
+// than each move, and the JIT can bounds-check the whole loop once on entry.
+static void Program_fold_loop(Program* program, size_t open) {
+    int offset = 0, moves = 0;
+    size_t out = open + 1;
+
+    for (size_t i = open + 1; i < program->length; i++) {
+        const Instruction* ins = &program->code[i];
+        if (ins->op == OP_MOVE) {
+            offset += ins->arg;
+            moves++;
+            if (offset <= -TAPE_SIZE || offset >= TAPE_SIZE)
+                return;
+        } else if (ins->op != OP_ADD && ins->op != OP_IN && ins->op != OP_OUT && ins->op != OP_CLEAR)
+            return; // A nested loop, scan or multiply
+    }
+    if (offset != 0 || moves == 0)
+        return;
+
+    for (size_t i = open + 1; i < program->length; i++) {
+        if (program->code[i].op == OP_MOVE) {
+            offset += program->code[i].arg;
+            continue;
+        }
+        program->code[out] = program->code[i];
+        program->code[out].offset = offset;
+        program->source[out] = program->source[i];
+        out++;
+    }
+    program->length = out;
+}
+
+// Translates source text into bytecode: non-command characters are skipped,
+// runs of +/- and >/< are folded, brackets are matched up front, and clear
+// and multiply loops are replaced and balanced loops folded into offsets as
+// soon as they are closed.
+int Program_compile(Program* program, const char* code, size_t code_len) {
+    size_t capacity = 0;
+    size_t* stack = NULL;
+    size_t depth = 0, stack_capacity = 0;
+    int status = BF_OK;
+
+    program->code = NULL;
+    program->source = NULL;
+    program->length = 0;
+
+    for (size_t i = 0; i < code_len && status == BF_OK; i++) {
+        switch (code[i]) {
+            case '+': status = Program_emit_run(program, &capacity, OP_ADD, 1, i); break;
+            case '-': status = Program_emit_run(program, &capacity, OP_ADD, -1, i); break;
+            case '>': status = Program_emit_run(program, &capacity, OP_MOVE, 1, i); break;
+            case '<': status = Program_emit_run(program, &capacity, OP_MOVE, -1, i); break;
+            case ',': status = Program_emit(program, &capacity, OP_IN, 0, i); break;
+            case '.': status = Program_emit(program, &capacity, OP_OUT, 0, i); break;
+            case '[':
+                if (depth == stack_capacity) {
+                    size_t new_capacity = stack_capacity ? stack_capacity * 2 : 32;
+                    size_t* new_stack = (size_t*)realloc(stack, new_capacity * sizeof(size_t));
+                    if (!new_stack) {
+                        status = BF_ERR_NO_MEMORY;
+                        break;
+                    }
+                    stack = new_stack;
+                    stack_capacity = new_capacity;
+                }
+                stack[depth++] = program->length;
+                status = Program_emit(program, &capacity, OP_JZ, 0, i);
+                break;
+            case ']':
+                if (depth == 0) {
+                    DebugPrintInterpreter("Program_compile: Unmatched closing bracket at %zu.\n", i);
+                    status = BF_ERR_MISMATCHED_BRACKETS;
+                    break;
+                }
+                size_t open = stack[--depth];
+                int rewritten = Program_optimize_loop(program, &capacity, open);
+                if (rewritten < 0)
+                    status = BF_ERR_NO_MEMORY;
+                else if (rewritten == 0) {
+                    Program_fold_loop(program, open);
+                    status = Program_emit(program, &capacity, OP_JNZ, (int)open + 1, i);
+                    if (status == BF_OK)
+                        program->code[open].arg = (int)program->length;
+                }
+                break;
+        }
+    }
+    if (status == BF_OK && depth != 0) {
+        DebugPrintInterpreter("Program_compile: %zu unmatched opening bracket(s).\n", depth);
+        status = BF_ERR_MISMATCHED_BRACKETS;
+    }
+    free(stack);
+    if (status != BF_OK)
+        Program_free(program);
+    return status;
+}
+
+// Finds the first unmatched ] in code or, failing that, the innermost [ left
+// open at the end, without compiling anything. Returns BF_OK if the brackets
+// balance, else BF_ERR_MISMATCHED_BRACKETS with the bracket's offset in
+// *error_offset.
+int Program_check_brackets(const char* code, size_t code_len, size_t* error_offset) {
+    size_t depth = 0;
+    for (size_t i = 0; i < code_len; i++) {
+        if (code[i] == '[')
+            depth++;
+        else if (code[i] == ']') {
+            if (depth == 0) {
+                *error_offset = i;
+                return BF_ERR_MISMATCHED_BRACKETS;
+            }
+            depth--;
+        }
+    }
+    if (depth == 0)
+        return BF_OK;
+    // Walking back, the first [ with no ] after it to pair with is the innermost open one.
+    depth = 0;
+    for (size_t i = code_len; i-- > 0; ) {
+        if (code[i] == ']')
+            depth++;
+        else if (code[i] == '[') {
+            if (depth == 0) {
+                *error_offset = i;
+                break;
+            }
+            depth--;
+        }
+    }
+    return BF_ERR_MISMATCHED_BRACKETS;
+}
+
+void Program_free(Program* program) {
+    free(program->code);
+    free(program->source);
+    program->code = NULL;
+    program->source = NULL;
+    program->length = 0;
+}
+
+// FNV-1a over the bytecode. Checkpoints record it, so they are only resumed
+// with the program, and the compiler, that wrote them.
+unsigned long long Program_hash(const Program* program) {
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < program->length; i++) {
+        const unsigned int fields[3] = { (unsigned int)program->code[i].op, (unsigned int)program->code[i].arg, (unsigned int)program->code[i].offset };
+        for (int f = 0; f < 3; f++)
+            for (int byte = 0; byte < 4; byte++) {
+                hash ^= (fields[f] >> (byte * 8)) & 0xFF;
+                hash *= 0x100000001b3ULL;
+            }
+    }
+    return hash;
+}
+
+// --- Profiling ---
+// Keeps loops[0..count) sorted by instructions, hottest first.
+static size_t Profile_insert(LoopProfile* loops, size_t count, size_t max, const LoopProfile* loop) {
+    size_t i = count < max ? count++ : max;
+    if (i == max && (max == 0 || loop->instructions <= loops[max - 1].instructions))
+        return count;
+    if (i == max)
+        i = max - 1;
+    while (i > 0 && loops[i - 1].instructions < loop->instructions) {
+        loops[i] = loops[i - 1];
+        i--;
+    }
+    loops[i] = *loop;
+    return count;
+}
+
+// Ranks the program's loops by the instructions executed in their own body,
+// given the per-instruction counts collected by Machine_run. Instructions of
+// nested loops are charged to the nested loop, so an outer loop only ranks
+// high for the work it does itself. Fills at most max entries, hottest first,
+// and returns how many were filled.
+size_t Program_profile_loops(const Program* program, const unsigned long long* counts, LoopProfile* loops, size_t max) {
+    LoopProfile* open = (LoopProfile*)malloc((program->length / 2 + 1) * sizeof(LoopProfile));
+    size_t depth = 0, count = 0;
+    if (!open)
+        return 0;
+
+    for (size_t pc = 0; pc < program->length; pc++) {
+        if (program->code[pc].op == OP_JZ) {
+            if (depth > 0)
+                open[depth - 1].instructions += counts[pc];
+            open[depth].start = program->source[pc];
+            open[depth].instructions = 0;
+            depth++;
+        } else if (depth > 0) {
+            LoopProfile* loop = &open[depth - 1];
+            loop->instructions += counts[pc];
+            if (program->code[pc].op == OP_JNZ) {
+                loop->end = program->source[pc];
+                loop->iterations = counts[pc];
+                if (loop->instructions > 0)
+                    count = Profile_insert(loops, count, max, loop);
+                depth--;
+            }
+        }
+    }
+    free(open);
+    return count;
+}
+
+// --- C Export ---
+static void Program_export_cell(FILE* file, int offset) {
+    if (offset == 0)
+        fprintf(file, "t[p]");
+    else
+        fprintf(file, "t[WRAP(p + %uu)]", (unsigned int)offset);
+}
+
+// Writes the program as a standalone C source that reads stdin and writes
+// stdout with the same semantics as the interpreters: wrapping cells of the
+// given width, a tape of tape_size cells that wraps around and 0 stored on
+// EOF. The tape is a zero-initialized static array, which the loader also
+// maps on demand.
+int Program_export_c(const Program* program, size_t tape_size, int cell_width, FILE* file) {
+    const unsigned int cell_mask = (unsigned int)(0xFFFFFFFFull >> (32 - (8 << cell_width)));
+    int depth = 1;
+
+    fprintf(file,
+        "/* Generated by BF Interpreter. */\n"
+        "#include <stdint.h>\n"
+        "#include <stdio.h>\n"
+        "#ifdef _WIN32\n"
+        "#include <fcntl.h>\n"
+        "#include <io.h>\n"
+        "#endif\n"
+        "\n"
+        "#define TAPE_SIZE %luu\n"
+        "#define WRAP(p) ((p) & (TAPE_SIZE - 1))\n"
+        "\n"
+        "typedef uint%d_t cell;\n"
+        "static cell t[TAPE_SIZE];\n"
+        "static char output_buffer[65536];\n"
+        "\n"
+        "int main(void) {\n"
+        "    unsigned int p = 0;\n"
+        "    int c;\n"
+        "#ifdef _WIN32\n"
+        "    _setmode(_fileno(stdin), _O_BINARY);\n"
+        "    _setmode(_fileno(stdout), _O_BINARY);\n"
+        "#endif\n"
+        "    setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));\n"
+        "    (void)c;\n",
+        (unsigned long)tape_size, 8 << cell_width);
+
+    for (size_t pc = 0; pc < program->length; pc++) {
+        const Instruction* ins = &program->code[pc];
+        if (ins->op == OP_JNZ)
+            depth--;
+        fprintf(file, "%*s", depth * 4, "");
+        switch (ins->op) {
+            case OP_ADD:
+                Program_export_cell(file, ins->offset);
+                fprintf(file, " += %uu;\n", (unsigned int)ins->arg & cell_mask);
+                break;
+            case OP_MOVE: fprintf(file, "p = WRAP(p + %uu);\n", (unsigned int)ins->arg); break;
+            case OP_IN:
+                fprintf(file, "c = getchar(); ");
+                Program_export_cell(file, ins->offset);
+                fprintf(file, " = c == EOF ? 0 : (unsigned char)c;\n");
+                break;
+            case OP_OUT:
+                fprintf(file, "putchar((unsigned char)");
+                Program_export_cell(file, ins->offset);
+                fprintf(file, ");\n");
+                break;
+            case OP_JZ: fprintf(file, "while (t[p]) {\n"); depth++; break;
+            case OP_JNZ: fprintf(file, "}\n"); break;
+            case OP_CLEAR:
+                Program_export_cell(file, ins->offset);
+                fprintf(file, " = 0;\n");
+                break;
+            case OP_MULADD:
+                fprintf(file, "t[WRAP(p + %uu)] += (cell)(t[p] * %uu);\n", (unsigned int)ins->offset, (unsigned int)ins->arg & cell_mask);
+                break;
+            case OP_SCAN: fprintf(file, "while (t[p]) p = WRAP(p + %uu);\n", (unsigned int)ins->arg); break;
+        }
+    }
+    fprintf(file, "    fflush(stdout);\n    return 0;\n}\n");
+    fflush(file);
+    return ferror(file) ? BF_ERR_IO : BF_OK;
+}
+
+// --- Interpreter ---
+int Machine_init(Machine* machine, int tape_mode, int cell_width) {
+    memset(machine, 0, sizeof(*machine));
+    return Tape_init(&machine->tape, tape_mode, cell_width);
+}
+
+void Machine_free(Machine* machine) {
+    Tape_free(&machine->tape);
+}
+
+// Passes the buffered output to output_callback. Output past output_limit
+// is dropped and the limit is recorded for the next Machine_poll.
+void Machine_flush_output(Machine* machine) {
+    size_t length = machine->output_buffer_pos;
+    if (length == 0)
+        return;
+    if (machine->output_limit && machine->output_total + length > machine->output_limit) {
+        length = (size_t)(machine->output_limit - machine->output_total);
+        if (machine->stop_status == BF_OK)
+            machine->stop_status = BF_OUTPUT_LIMIT;
+    }
+    if (length > 0)
+        machine->output_callback(machine->output_context, machine->output_buffer, length);
+    machine->output_total += length;
+    machine->output_buffer_pos = 0;
+}
+
+// Milliseconds from an arbitrary start, wrapping at 2^32. Only differences
+// are used, so the wrap is harmless for runs shorter than 49 days.
+static unsigned int Machine_clock_ms(void) {
+#ifdef _WIN32
+    return (unsigned int)GetTickCount();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)((unsigned long long)now.tv_sec * 1000u + (unsigned long long)now.tv_nsec / 1000000u);
+#endif
+}
+
+// Checks the stop signal and the limits. Engines call this once per
+// POLL_QUANTUM instructions, after adding them to machine->charged, and stop
+// with the returned status unless it is BF_OK.
+int Machine_poll(Machine* machine) {
+    if (machine->stop_status != BF_OK)
+        return machine->stop_status;
+    if (!*machine->running)
+        machine->stop_status = BF_STOPPED;
+    else if (machine->step_limit && machine->charged >= machine->step_limit)
+        machine->stop_status = BF_STEP_LIMIT;
+    else if (machine->time_limit_ms && Machine_clock_ms() - machine->start_ms >= machine->time_limit_ms)
+        machine->stop_status = BF_TIME_LIMIT;
+    else if (machine->checkpoint_interval_ms && Machine_clock_ms() - machine->checkpoint_ms >= machine->checkpoint_interval_ms)
+        machine->stop_status = BF_CHECKPOINT;
+    return machine->stop_status;
+}
+
+// Returns the next input byte, refilling from input_callback when the
+// current chunk is used up, or 0 at end of input. Pending output is flushed
+// first so prompts are visible before the input callback blocks.
+int Machine_read_input(Machine* machine) {
+    if (machine->input_pos >= machine->input_len && machine->input_callback) {
+        Machine_flush_output(machine);
+        machine->input_offset += machine->input_len;
+        machine->input_len = machine->input_callback(machine->input_context, &machine->input);
+        machine->input_pos = 0;
+    }
+    if (machine->input_pos < machine->input_len)
+        return (unsigned char)machine->input[machine->input_pos++];
+    return 0;
+}
+
+// --- Tracing ---
+int TraceRing_init(TraceRing* ring, size_t capacity) {
+    size_t size = 1;
+    while (size < capacity && size <= ((size_t)-1 >> 1) / sizeof(TraceRecord))
+        size <<= 1;
+    ring->records = (TraceRecord*)malloc(size * sizeof(TraceRecord));
+    ring->capacity = ring->records ? size : 0;
+    ring->count = 0;
+    return ring->records ? BF_OK : BF_ERR_NO_MEMORY;
+}
+
+void TraceRing_free(TraceRing* ring) {
+    free(ring->records);
+    ring->records = NULL;
+    ring->capacity = 0;
+}
+
+// Writes the records still in the ring, oldest first, after a header of
+// TRACE_FILE_MAGIC, the record size and the total and kept record counts.
+// Fields are written in the host's byte order.
+int TraceRing_dump(const TraceRing* ring, FILE* file) {
+    unsigned long long kept = ring->count < ring->capacity ? ring->count : ring->capacity;
+    unsigned int record_size = (unsigned int)sizeof(TraceRecord), reserved = 0;
+    size_t first = (size_t)((ring->count - kept) & (ring->capacity - 1));
+    size_t head = (size_t)kept < ring->capacity - first ? (size_t)kept : ring->capacity - first;
+
+    fwrite(TRACE_FILE_MAGIC, 1, 8, file);
+    fwrite(&record_size, sizeof(record_size), 1, file);
+    fwrite(&reserved, sizeof(reserved), 1, file);
+    fwrite(&ring->count, sizeof(ring->count), 1, file);
+    fwrite(&kept, sizeof(kept), 1, file);
+    if (kept > 0) {
+        fwrite(ring->records + first, sizeof(TraceRecord), head, file);
+        fwrite(ring->records, sizeof(TraceRecord), (size_t)kept - head, file);
+    }
+    fflush(file);
+    return ferror(file) ? BF_ERR_IO : BF_OK;
+}
+
+// --- Direct-threaded Interpreter ---
+// Labels-as-values are a GCC/Clang extension; other compilers get the same
+// loop dispatched through a switch.
+#if defined(__GNUC__) || defined(__clang__)
+#define BF_COMPUTED_GOTO 1
+#define BF_INLINE inline __attribute__((always_inline))
+#else
+#define BF_INLINE inline
+#endif
+
+typedef struct {
+#ifdef BF_COMPUTED_GOTO
+    const void* handler;
+#else
+    int op;
+#endif
+    int arg;
+    int offset;
+} ThreadedInstruction;
+
+// Offset forms of OP_ADD, OP_IN, OP_OUT and OP_CLEAR, only used inside the
+// threaded engine.
+enum {
+    OP_ADD_AT = OP_END + 1,
+    OP_IN_AT,
+    OP_OUT_AT,
+    OP_CLEAR_AT
+};
+
+static int Threaded_op(const Instruction* ins) {
+    if (ins->offset != 0) {
+        switch (ins->op) {
+            case OP_ADD: return OP_ADD_AT;
+            case OP_IN: return OP_IN_AT;
+            case OP_OUT: return OP_OUT_AT;
+            case OP_CLEAR: return OP_CLEAR_AT;
+        }
+    }
+    return ins->op;
+}
+
+#ifdef BF_COMPUTED_GOTO
+#define TARGET(op) label_##op:
+#define DISPATCH() goto *ip->handler
+#else
+#define TARGET(op) case op:
+#define DISPATCH() goto dispatch
+#endif
+
+// --- Width-specialized engines ---
+#define CELL_TYPE unsigned char
+#define CELL_NAME(name) name##_8
+#include "bfcell.h"
+#undef CELL_TYPE
+#undef CELL_NAME
+
+#define CELL_TYPE uint16_t
+#define CELL_NAME(name) name##_16
+#include "bfcell.h"
+#undef CELL_TYPE
+#undef CELL_NAME
+
+#define CELL_TYPE uint32_t
+#define CELL_NAME(name) name##_32
+#include "bfcell.h"
+#undef CELL_TYPE
+#undef CELL_NAME
+
+#undef TARGET
+#undef DISPATCH
+
+int Machine_run(Machine* machine, const Program* program) {
+    switch (machine->tape.cell_width) {
+        case CELL_16BIT: return Machine_run_16(machine, program);
+        case CELL_32BIT: return Machine_run_32(machine, program);
+        default: return Machine_run_8(machine, program);
+    }
+}
+
+int Machine_run_threaded(Machine* machine, const Program* program) {
+    switch (machine->tape.cell_width) {
+        case CELL_16BIT: return Machine_run_threaded_16(machine, program);
+        case CELL_32BIT: return Machine_run_threaded_32(machine, program);
+        default: return Machine_run_threaded_8(machine, program);
+    }
+}
+
+int Machine_run_engine(Machine* machine, const Program* program, int engine) {
+    int status;
+    // Only the reference interpreter traces.
+    if (machine->trace)
+        engine = ENGINE_SWITCH;
+    machine->start_ms = machine->checkpoint_ms = Machine_clock_ms();
+    for (;;) {
+        switch (engine) {
+            case ENGINE_THREADED: status = Machine_run_threaded(machine, program); break;
+            case ENGINE_JIT: status = Machine_run_jit(machine, program); break;
+            default: status = Machine_run(machine, program); break;
+        }
+        if (status != BF_CHECKPOINT)
+            break;
+        // The engine stopped at machine->pc with its output flushed, so the
+        // state is complete; save it and carry on from there.
+        machine->stop_status = BF_OK;
+        machine->checkpoint_callback(machine->checkpoint_context, machine, program);
+        machine->checkpoint_ms = Machine_clock_ms();
+    }
+    // The final flush can reach the output limit after the last poll.
+    if (status == BF_OK)
+        status = machine->stop_status;
+    return status;
+}
+
+// --- Checkpoints ---
+// A checkpoint file is CHECKPOINT_MAGIC, the program hash, the tape geometry,
+// the machine's counters, and then every CHECKPOINT_BLOCK_SIZE block of the
+// tape that holds a nonzero byte, each preceded by its block index. Index
+// CHECKPOINT_END ends the file. Fields are in the host's byte order.
+#define CHECKPOINT_MAGIC        "BFSNAP01"
+#define CHECKPOINT_BLOCK_SIZE   4096
+#define CHECKPOINT_END          (~0ULL)
+
+typedef struct {
+    unsigned long long program_hash;
+    unsigned long long cells;
+    unsigned int cell_width;
+    unsigned int position;
+    unsigned long long pc;
+    unsigned long long steps;
+    unsigned long long input_consumed;
+    unsigned long long output_total; // Output written before the checkpoint
+} CheckpointHeader;
+
+static void Checkpoint_write_block(FILE* file, const unsigned char* tape, size_t offset) {
+    static const unsigned char zero[CHECKPOINT_BLOCK_SIZE];
+    unsigned long long index = offset / CHECKPOINT_BLOCK_SIZE;
+    if (memcmp(tape + offset, zero, CHECKPOINT_BLOCK_SIZE) == 0)
+        return;
+    fwrite(&index, sizeof(index), 1, file);
+    fwrite(tape + offset, 1, CHECKPOINT_BLOCK_SIZE, file);
+}
+
+#ifdef _WIN32
+// Writes the blocks of a mapped tape's committed regions. Reading the rest
+// would fault every reserved chunk in; a tape committed up front is one
+// region, so it is scanned whole.
+static void Checkpoint_write_committed(FILE* file, const Tape* tape, size_t bytes) {
+    size_t start = 0;
+    while (start < bytes) {
+        MEMORY_BASIC_INFORMATION region;
+        if (VirtualQuery(tape->tape + start, &region, sizeof(region)) == 0)
+            return;
+        size_t end = (size_t)((unsigned char*)region.BaseAddress - tape->tape) + region.RegionSize;
+        if (end > bytes)
+            end = bytes;
+        if (region.State == MEM_COMMIT)
+            for (size_t offset = start; offset < end; offset += CHECKPOINT_BLOCK_SIZE)
+                Checkpoint_write_block(file, tape->tape, offset);
+        start = end;
+    }
+}
+#endif
+
+// Saves everything needed to resume the run at machine->pc: call it after
+// the engine has returned, when the output is flushed. Input is recorded as
+// the number of bytes consumed, not the bytes themselves.
+int Machine_save_checkpoint(const Machine* machine, const Program* program, FILE* file) {
+    const Tape* tape = &machine->tape;
+    const size_t bytes = Tape_size(tape) << tape->cell_width;
+    CheckpointHeader header;
+    unsigned long long end = CHECKPOINT_END;
+
+    memset(&header, 0, sizeof(header));
+    header.program_hash = Program_hash(program);
+    header.cells = Tape_size(tape);
+    header.cell_width = (unsigned int)tape->cell_width;
+    header.position = (unsigned int)tape->position;
+    header.pc = machine->pc;
+    header.steps = machine->steps;
+    header.input_consumed = machine->input_offset + machine->input_pos;
+    header.output_total = machine->output_total;
+
+    fwrite(CHECKPOINT_MAGIC, 1, 8, file);
+    fwrite(&header, sizeof(header), 1, file);
+#ifdef _WIN32
+    if (tape->mapped)
+        Checkpoint_write_committed(file, tape, bytes);
+    else
+#endif
+    // Untouched pages of a mapped tape read as the shared zero page here,
+    // so scanning them costs time but no memory.
+    for (size_t offset = 0; offset < bytes; offset += CHECKPOINT_BLOCK_SIZE)
+        Checkpoint_write_block(file, tape->tape, offset);
+    fwrite(&end, sizeof(end), 1, file);
+    fflush(file);
+    return ferror(file) ? BF_ERR_IO : BF_OK;
+}
+
+// Skips count input bytes, refilling through input_callback as needed.
+// Returns 0 if the input ends first.
+static int Machine_skip_input(Machine* machine, unsigned long long count) {
+    while (count > 0) {
+        size_t left = machine->input_len - machine->input_pos;
+        if (left == 0) {
+            if (!machine->input_callback)
+                return 0;
+            machine->input_offset += machine->input_len;
+            machine->input_len = machine->input_callback(machine->input_context, &machine->input);
+            machine->input_pos = 0;
+            if (machine->input_len == 0)
+                return 0;
+            continue;
+        }
+        size_t step = count < left ? (size_t)count : left;
+        machine->input_pos += step;
+        count -= step;
+    }
+    return 1;
+}
+
+// Restores a checkpoint into a machine that was just initialized with the
+// checkpoint's tape mode and cell width and given the same input as the
+// original run, which is skipped up to where the checkpoint was taken.
+// Machine_run_engine then continues from the checkpoint, with the limits
+// counting from there and only new output passed on. Returns
+// BF_ERR_CHECKPOINT if the file belongs to another program or tape, or is
+// not a checkpoint, and BF_ERR_IO if it is truncated or the input is short.
+int Machine_load_checkpoint(Machine* machine, const Program* program, FILE* file) {
+    Tape* tape = &machine->tape;
+    const size_t bytes = Tape_size(tape) << tape->cell_width;
+    char magic[8];
+    CheckpointHeader header;
+    unsigned long long index;
+
+    if (fread(magic, 1, 8, file) != 8 || memcmp(magic, CHECKPOINT_MAGIC, 8) != 0)
+        return BF_ERR_CHECKPOINT;
+    if (fread(&header, sizeof(header), 1, file) != 1)
+        return BF_ERR_IO;
+    if (header.program_hash != Program_hash(program) || header.cells != Tape_size(tape) ||
+        header.cell_width != (unsigned int)tape->cell_width || header.position > tape->mask || header.pc > program->length)
+        return BF_ERR_CHECKPOINT;
+    // Runs only stop at the start, the end, an opening bracket or a scan,
+    // and the JIT can only be entered there.
+    if (header.pc != 0 && header.pc != program->length &&
+        program->code[header.pc].op != OP_JZ && program->code[header.pc].op != OP_SCAN)
+        return BF_ERR_CHECKPOINT;
+
+    for (;;) {
+        if (fread(&index, sizeof(index), 1, file) != 1)
+            return BF_ERR_IO;
+        if (index == CHECKPOINT_END)
+            break;
+        if (index >= bytes / CHECKPOINT_BLOCK_SIZE)
+            return BF_ERR_CHECKPOINT;
+        if (fread(tape->tape + index * CHECKPOINT_BLOCK_SIZE, 1, CHECKPOINT_BLOCK_SIZE, file) != CHECKPOINT_BLOCK_SIZE)
+            return BF_ERR_IO;
+    }
+
+    tape->position = (int)header.position;
+    machine->pc = (size_t)header.pc;
+    machine->steps = header.steps;
+    return Machine_skip_input(machine, header.input_consumed) ? BF_OK : BF_ERR_IO;
+}
+
+// --- Partial Evaluation ---
+// Program_evaluate_prefix steps the program on a fresh tape with the plain
+// Tape accessors until it would read input, the budget runs out or the
+// output reaches PREFIX_MAX_OUTPUT. The engines can only be entered at the
+// start, the end, an opening bracket, a scan or an instruction outside any
+// loop, so the prefix ends at the last such point passed. If evaluation
+// stopped elsewhere, inside a loop body, it is replayed from the start up to
+// that point.
+
+typedef struct {
+    Tape tape;
+    size_t pc;
+    size_t depth;          // Loops entered and not yet left
+    long long head;        // Head position before wrapping
+    long long low, high;   // Range of head positions so far
+    unsigned long long steps;
+    char* output;
+    size_t output_length;
+    size_t output_capacity;
+} PrefixState;
+
+// An entry point passed during evaluation, with the progress made by then.
+typedef struct {
+    size_t pc;
+    unsigned long long steps;
+    size_t output_length;
+} PrefixPoint;
+
+static unsigned int Prefix_index(const PrefixState* state, int offset) {
+    return (unsigned int)(state->head + offset) & state->tape.mask;
+}
+
+static void Prefix_move(PrefixState* state, int delta) {
+    state->head += delta;
+    if (state->head < state->low)
+        state->low = state->head;
+    if (state->head > state->high)
+        state->high = state->head;
+}
+
+static void Prefix_mark(const PrefixState* state, size_t pc, PrefixPoint* point) {
+    point->pc = pc;
+    point->steps = state->steps;
+    point->output_length = state->output_length;
+}
+
+// Runs until the program would read input or ends, or limit instructions or
+// PREFIX_MAX_OUTPUT bytes of output are reached, leaving the last entry
+// point passed in *point.
+static int Prefix_run(PrefixState* state, const Program* program, unsigned long long limit, PrefixPoint* point) {
+    for (;;) {
+        const size_t pc = state->pc;
+        if (pc == program->length || state->depth == 0 || program->code[pc].op == OP_JZ || program->code[pc].op == OP_SCAN)
+            Prefix_mark(state, pc, point);
+        if (pc == program->length || state->steps >= limit || state->output_length >= PREFIX_MAX_OUTPUT)
+            return BF_OK;
+
+        const Instruction* ins = &program->code[pc];
+        unsigned int cell = Tape_load(&state->tape, Prefix_index(state, 0));
+        unsigned int index = Prefix_index(state, ins->offset);
+        if (ins->op == OP_IN)
+            return BF_OK;
+        state->steps++;
+        state->pc++;
+        switch (ins->op) {
+            case OP_ADD:
+                Tape_store(&state->tape, index, Tape_load(&state->tape, index) + (unsigned int)ins->arg);
+                break;
+            case OP_MOVE:
+                Prefix_move(state, ins->arg);
+                break;
+            case OP_OUT:
+                if (state->output_length == state->output_capacity) {
+                    size_t capacity = state->output_capacity ? state->output_capacity * 2 : 256;
+                    char* output = (char*)realloc(state->output, capacity);
+                    if (!output)
+                        return BF_ERR_NO_MEMORY;
+                    state->output = output;
+                    state->output_capacity = capacity;
+                }
+                state->output[state->output_length++] = (char)Tape_load(&state->tape, index);
+                break;
+            case OP_JZ:
+                if (cell == 0)
+                    state->pc = (size_t)ins->arg;
+                else
+                    state->depth++;
+                break;
+            case OP_JNZ:
+                if (cell != 0) {
+                    // Going round again is the same as entering at the opening bracket.
+                    state->pc = (size_t)ins->arg;
+                    Prefix_mark(state, (size_t)ins->arg - 1, point);
+                } else
+                    state->depth--;
+                break;
+            case OP_CLEAR:
+                Tape_store(&state->tape, index, 0);
+                break;
+            case OP_MULADD:
+                Tape_store(&state->tape, index, Tape_load(&state->tape, index) + cell * (unsigned int)ins->arg);
+                break;
+            case OP_SCAN:
+                // A scan cut off by the limit resumes at the scan, with the head where it got to.
+                while (cell != 0 && state->steps < limit) {
+                    Prefix_move(state, ins->arg);
+                    state->steps++;
+                    cell = Tape_load(&state->tape, Prefix_index(state, 0));
+                }
+                if (cell != 0)
+                    state->pc = pc;
+                break;
+        }
+    }
+}
+
+// Saves the tape's nonzero blocks among the cells offsets low to high from
+// the start cell, which take in all the cells the prefix can have touched.
+static int Prefix_save_tape(const PrefixState* state, long long low, long long high, ProgramPrefix* prefix) {
+    static const unsigned char zero[PREFIX_BLOCK_SIZE];
+    const Tape* tape = &state->tape;
+    const size_t cells = Tape_size(tape);
+    size_t ranges[2][2];
+    int range_count = 1;
+
+    if (high - low + 1 >= (long long)cells) {
+        ranges[0][0] = 0;
+        ranges[0][1] = cells;
+    } else {
+        size_t first = (unsigned int)low & tape->mask, last = (unsigned int)high & tape->mask;
+        ranges[0][0] = first;
+        ranges[0][1] = first <= last ? last + 1 : cells;
+        if (first > last) {
+            ranges[1][0] = 0;
+            ranges[1][1] = last + 1;
+            range_count = 2;
+        }
+    }
+    for (int r = 0; r < range_count; r++) {
+        size_t start = (ranges[r][0] << tape->cell_width) / PREFIX_BLOCK_SIZE;
+        size_t end = ((ranges[r][1] << tape->cell_width) + PREFIX_BLOCK_SIZE - 1) / PREFIX_BLOCK_SIZE;
+        for (size_t block = start; block < end; block++) {
+            const unsigned char* data = tape->tape + block * PREFIX_BLOCK_SIZE;
+            if (memcmp(data, zero, PREFIX_BLOCK_SIZE) == 0)
+                continue;
+            size_t* block_index = (size_t*)realloc(prefix->block_index, (prefix->block_count + 1) * sizeof(size_t));
+            if (!block_index)
+                return BF_ERR_NO_MEMORY;
+            prefix->block_index = block_index;
+            unsigned char* blocks = (unsigned char*)realloc(prefix->blocks, (prefix->block_count + 1) * PREFIX_BLOCK_SIZE);
+            if (!blocks)
+                return BF_ERR_NO_MEMORY;
+            prefix->blocks = blocks;
+            memcpy(blocks + prefix->block_count * PREFIX_BLOCK_SIZE, data, PREFIX_BLOCK_SIZE);
+            block_index[prefix->block_count++] = block;
+        }
+    }
+    return BF_OK;
+}
+
+// Evaluates the program from the start on a fresh tape of the given mode and
+// width, without input, for at most budget instructions. The result applies
+// to runs on a tape of the same size and width; prefix->pc is 0 if the
+// program reads input or loops before it reaches an entry point.
+int Program_evaluate_prefix(const Program* program, int tape_mode, int cell_width, unsigned long long budget, ProgramPrefix* prefix) {
+    PrefixState state;
+    PrefixPoint point = { 0, 0, 0 };
+    int min_offset = 0, max_offset = 0;
+
+    memset(prefix, 0, sizeof(*prefix));
+    memset(&state, 0, sizeof(state));
+    for (size_t i = 0; i < program->length; i++) {
+        if (program->code[i].offset < min_offset)
+            min_offset = program->code[i].offset;
+        if (program->code[i].offset > max_offset)
+            max_offset = program->code[i].offset;
+    }
+
+    int status = Tape_init(&state.tape, tape_mode, cell_width);
+    if (status == BF_OK)
+        status = Prefix_run(&state, program, budget, &point);
+    if (status == BF_OK && point.steps != state.steps) {
+        Tape_free(&state.tape);
+        state.pc = state.depth = 0;
+        state.head = state.low = state.high = 0;
+        state.steps = 0;
+        state.output_length = 0;
+        status = Tape_init(&state.tape, tape_mode, cell_width);
+        if (status == BF_OK)
+            status = Prefix_run(&state, program, point.steps, &point);
+    }
+    if (status == BF_OK)
+        status = Prefix_save_tape(&state, state.low + min_offset, state.high + max_offset, prefix);
+    if (status == BF_OK) {
+        prefix->cells = Tape_size(&state.tape);
+        prefix->cell_width = cell_width;
+        prefix->pc = point.pc;
+        prefix->position = (int)Prefix_index(&state, 0);
+        prefix->steps = point.steps;
+        prefix->output = state.output;
+        prefix->output_length = point.output_length;
+        state.output = NULL;
+    }
+    Tape_free(&state.tape);
+    free(state.output);
+    if (status != BF_OK)
+        ProgramPrefix_free(prefix);
+    return status;
+}
+
+void ProgramPrefix_free(ProgramPrefix* prefix) {
+    free(prefix->output);
+    free(prefix->block_index);
+    free(prefix->blocks);
+    memset(prefix, 0, sizeof(*prefix));
+}
+
+// Starts a fresh run where the prefix left off: call it right after
+// Machine_init, once the output is set up, on a tape of the size and width
+// the prefix was evaluated on. The prefix's output is written first and its
+// instructions are charged against the step limit. Returns BF_ERR_CHECKPOINT,
+// leaving the machine untouched, if the tape differs.
+int Machine_apply_prefix(Machine* machine, const ProgramPrefix* prefix) {
+    Tape* tape = &machine->tape;
+    if (prefix->cells != Tape_size(tape) || prefix->cell_width != tape->cell_width)
+        return BF_ERR_CHECKPOINT;
+    for (size_t i = 0; i < prefix->block_count; i++)
+        memcpy(tape->tape + prefix->block_index[i] * PREFIX_BLOCK_SIZE, prefix->blocks + i * PREFIX_BLOCK_SIZE, PREFIX_BLOCK_SIZE);
+    tape->position = prefix->position;
+    machine->pc = prefix->pc;
+    machine->charged += prefix->steps;
+    for (size_t i = 0; i < prefix->output_length; i++) {
+        if (machine->output_buffer_pos == machine->output_buffer_size)
+            Machine_flush_output(machine);
+        machine->output_buffer[machine->output_buffer_pos++] = prefix->output[i];
+    }
+    return BF_OK;
+}
@@ -0,0 +1,227 @@
+#ifndef BFENGINE_H
+#define BFENGINE_H
+
+// Portable Brainfuck compiler and execution engine. This file must not
+// depend on windows.h so the engine can be shared with non-GUI front ends.
+
+#include <stddef.h>
+#include <stdio.h>
+
+// --- Constants ---
+#define TAPE_SIZE           65536     // Cells in the default wrap-around tape
+#define MAX_RUN_LENGTH      (1 << 30) // Longest run folded into one instruction
+#define MAX_IDIOM_LENGTH    64        // Longest loop body considered for idioms
+#define POLL_QUANTUM        65536     // Instructions charged between stop and limit checks
+
+// Status codes returned by the compiler and the engine
+#define BF_OK                       0
+#define BF_ERR_MISMATCHED_BRACKETS  1
+#define BF_ERR_NO_MEMORY            2
+#define BF_STOPPED                  3
+#define BF_ERR_IO                   4
+#define BF_STEP_LIMIT               5 // Machine.step_limit instructions were charged
+#define BF_TIME_LIMIT               6 // Machine.time_limit_ms elapsed
+#define BF_OUTPUT_LIMIT             7 // Machine.output_limit bytes were written
+#define BF_ERR_CHECKPOINT           8 // Not a checkpoint of this program and tape
+#define BF_CHECKPOINT               9 // Internal: paused for an auto-checkpoint, see Machine_run_engine
+
+// --- Bytecode ---
+// OP_JZ and OP_JNZ store the index one past their partner in arg, so a taken
+// branch never re-executes the opposite bracket. OP_ADD, OP_IN, OP_OUT and
+// OP_CLEAR act on the cell offset cells from the head; the offset is only
+// nonzero inside loops whose moves were folded away (see Program_fold_loop).
+typedef enum {
+    OP_ADD,     // cell[offset] += arg, wrapping at the cell width
+    OP_MOVE,    // position += arg, wrapping at the tape size
+    OP_IN,      // cell[offset] = next input byte, 0 on EOF
+    OP_OUT,     // write cell[offset] to output
+    OP_JZ,      // if cell == 0: pc = arg
+    OP_JNZ,     // if cell != 0: pc = arg
+    OP_CLEAR,   // cell[offset] = 0, replaces [-] and [+]
+    OP_MULADD,  // cell[offset] += cell * arg, emitted ahead of an OP_CLEAR
+    OP_SCAN,    // move by arg until the cell is zero, replaces [>], [<<] etc.
+    OP_END      // end of program, only used inside engines
+} OpCode;
+
+// Execution engines selectable at run time
+#define ENGINE_SWITCH       0 // Reference switch loop; records into machine->trace when set
+#define ENGINE_THREADED     1 // Direct-threaded dispatch, no per-step calls
+#define ENGINE_JIT          2 // Native x86-64 code, threaded engine elsewhere
+#define ENGINE_COUNT        3
+
+typedef struct {
+    int op;
+    int arg;
+    int offset; // Cell offset relative to the head, see OpCode
+} Instruction;
+
+typedef struct {
+    Instruction* code;
+    size_t* source; // Source offset of the character each instruction came from
+    size_t length;
+} Program;
+
+// One loop's share of a profiled run, see Program_profile_loops.
+typedef struct {
+    size_t start;                    // Source offset of the loop's '['
+    size_t end;                      // Source offset of its ']'
+    unsigned long long iterations;   // Times the body ran
+    unsigned long long instructions; // Executed in the body, nested loops excluded
+} LoopProfile;
+
+// --- Tracing ---
+// One executed instruction, recorded just before it runs.
+typedef struct {
+    unsigned int pc;       // Bytecode index; Program.source gives its source offset
+    unsigned int op;       // OpCode
+    unsigned int position; // Head position
+    unsigned int cell;     // Value of the cell under the head
+} TraceRecord;
+
+// Keeps the last capacity records of a run, see TraceRing_dump for the file
+// format. capacity is a power of two, so the ring is indexed with a mask.
+typedef struct {
+    TraceRecord* records;
+    size_t capacity;
+    unsigned long long count; // Records written in all, including overwritten ones
+} TraceRing;
+
+#define TRACE_FILE_MAGIC    "BFTRACE1"
+
+// Tape modes selectable at run time
+#define TAPE_WRAP           0 // TAPE_SIZE cells that wrap around, the classic layout
+#define TAPE_LARGE          1 // TAPE_LARGE_SIZE cells backed by memory as they are touched
+#define TAPE_MODE_COUNT     2
+
+// Cell widths selectable at run time. A cell is 1 << width bytes, and each
+// width runs its own instantiation of the engines (see bfcell.h).
+#define CELL_8BIT           0
+#define CELL_16BIT          1
+#define CELL_32BIT          2
+#define CELL_WIDTH_COUNT    3
+
+// The large tape is a virtual reservation: the operating system supplies a
+// zeroed page the first time a cell in it is touched (on Windows, through a
+// fault handler in bfengine.c), so only the pages the program visits use
+// memory. Windows before XP commits the whole tape up front instead. The
+// tape is never smaller: Tape_init fails if it cannot be mapped. The head
+// starts at cell 0 and moving left wraps to the top end, so the tape grows
+// in both directions from the start cell.
+#define TAPE_LARGE_SIZE     (sizeof(void*) >= 8 ? (size_t)1 << 30 : (size_t)1 << 26)
+
+// --- Brainfuck Tape Structure ---
+typedef struct {
+    unsigned char* tape; // Cell storage, (mask + 1) << cell_width bytes
+    unsigned int mask;   // Cell count - 1; the cell count is a power of two
+    int position;
+    int cell_width;      // CELL_8BIT, CELL_16BIT or CELL_32BIT
+    int mapped;          // tape is a demand-zero mapping rather than a heap block
+} Tape;
+
+// --- Execution State ---
+// Called when the output buffer is full and once more when the run ends.
+typedef void (*OutputCallback)(void* context, const char* data, size_t length);
+// Called when the input is exhausted. Points *data at the next chunk and
+// returns its length, or returns 0 at end of input.
+typedef size_t (*InputCallback)(void* context, const char** data);
+
+typedef struct Machine Machine;
+// Called by Machine_run_engine every checkpoint_interval_ms while the run is
+// paused at a resumable point, normally to call Machine_save_checkpoint.
+typedef void (*CheckpointCallback)(void* context, Machine* machine, const Program* program);
+
+struct Machine {
+    Tape tape;
+    size_t pc; // Instruction the run starts at; where a stopped run can resume
+    const char* input;
+    size_t input_len;
+    size_t input_pos;
+    InputCallback input_callback; // Optional; NULL when input is all in memory
+    void* input_context;
+    unsigned long long input_offset; // Input bytes consumed before the current chunk
+    char* output_buffer;
+    size_t output_buffer_size;
+    size_t output_buffer_pos;
+    OutputCallback output_callback;
+    void* output_context;
+    volatile int* running; // Cleared by another thread to stop the run
+    unsigned long long steps; // Instructions executed, counted by Machine_run only
+    unsigned long long* counts; // Optional per-instruction counts, filled by Machine_run only
+    TraceRing* trace; // Optional; when set, runs use the reference interpreter and record every step
+    // Limits, 0 for none. They are checked together with the stop signal
+    // (see Machine_poll), so a run may overshoot the step and time limits by
+    // up to POLL_QUANTUM instructions. Output is cut at exactly output_limit.
+    unsigned long long step_limit;
+    unsigned long long output_limit;
+    unsigned int time_limit_ms;
+    unsigned long long charged;      // Instructions charged against step_limit
+    unsigned long long output_total; // Bytes passed to output_callback
+    unsigned int start_ms;           // Clock reading when the run started
+    int stop_status;                 // First stop or limit status seen, else BF_OK
+    unsigned int checkpoint_interval_ms; // 0 for no auto-checkpoints
+    unsigned int checkpoint_ms;          // Clock reading at the last auto-checkpoint
+    CheckpointCallback checkpoint_callback;
+    void* checkpoint_context;
+};
+
+// --- Partial Evaluation ---
+// The state of a fresh run after the part of the program that reads no
+// input, worked out once by Program_evaluate_prefix so that each run can
+// start from there with Machine_apply_prefix. Tape blocks that are all zero
+// are left out.
+typedef struct {
+    unsigned long long cells; // Tape geometry the prefix was evaluated on
+    int cell_width;
+    size_t pc;                // Where runs continue; 0 if nothing was evaluated
+    int position;
+    unsigned long long steps; // Instructions evaluated
+    char* output;             // Output written by the prefix
+    size_t output_length;
+    size_t block_count;
+    size_t* block_index;      // Index of each saved block of PREFIX_BLOCK_SIZE bytes
+    unsigned char* blocks;    // block_count blocks, in block_index order
+} ProgramPrefix;
+
+#define PREFIX_BLOCK_SIZE   4096
+#define PREFIX_MAX_OUTPUT   (1024 * 1024) // Output a prefix may write before evaluation stops
+
+// Supplied by the host application.
+void DebugPrintInterpreter(const char* format, ...);
+
+int Tape_init(Tape* tape, int mode, int cell_width);
+void Tape_free(Tape* tape);
+size_t Tape_size(const Tape* tape);
+unsigned int Tape_get(Tape* tape);
+void Tape_set(Tape* tape, unsigned int value);
+void Tape_add(Tape* tape, int delta);
+void Tape_add_at(Tape* tape, int offset, int delta);
+void Tape_move(Tape* tape, int delta);
+int Tape_scan(Tape* tape, int stride);
+
+int Program_compile(Program* program, const char* code, size_t code_len);
+void Program_free(Program* program);
+int Program_check_brackets(const char* code, size_t code_len, size_t* error_offset);
+unsigned long long Program_hash(const Program* program);
+int Program_export_c(const Program* program, size_t tape_size, int cell_width, FILE* file);
+size_t Program_profile_loops(const Program* program, const unsigned long long* counts, LoopProfile* loops, size_t max);
+
+int TraceRing_init(TraceRing* ring, size_t capacity);
+void TraceRing_free(TraceRing* ring);
+int TraceRing_dump(const TraceRing* ring, FILE* file);
+
+int Machine_init(Machine* machine, int tape_mode, int cell_width);
+void Machine_free(Machine* machine);
+void Machine_flush_output(Machine* machine);
+int Machine_poll(Machine* machine);
+int Machine_read_input(Machine* machine);
+int Machine_run(Machine* machine, const Program* program);
+int Machine_run_threaded(Machine* machine, const Program* program);
+int Machine_run_jit(Machine* machine, const Program* program);
+int Machine_run_engine(Machine* machine, const Program* program, int engine);
+int Program_evaluate_prefix(const Program* program, int tape_mode, int cell_width, unsigned long long budget, ProgramPrefix* prefix);
+void ProgramPrefix_free(ProgramPrefix* prefix);
+int Machine_apply_prefix(Machine* machine, const ProgramPrefix* prefix);
+int Machine_save_checkpoint(const Machine* machine, const Program* program, FILE* file);
+int Machine_load_checkpoint(Machine* machine, const Program* program, FILE* file);
+
+#endif // BFENGINE_H
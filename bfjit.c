@@ -0,0 +1,577 @@
+// MAP_ANONYMOUS is not part of POSIX.1-2008. Must be before any system headers.
+#define _DEFAULT_SOURCE
+
+#include "bfengine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// x86-64 JIT backend. The bytecode is translated into native code that keeps
+// the cell array in r12, the head in r13, the Machine in r14 and the
+// back-edge poll counter in r15. I/O, scans, the stop signal and the limits
+// go through small C helpers so the Machine's buffering and Machine_poll are
+// shared with the interpreters.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BF_JIT_AVAILABLE 1
+#endif
+
+#ifdef BF_JIT_AVAILABLE
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int (*JitEntry)(Machine* machine, unsigned char* cells, unsigned int position);
+
+typedef struct {
+    unsigned char* data;
+    size_t length;
+    size_t capacity;
+    int failed;
+} JitBuffer;
+
+typedef struct {
+    size_t location; // Offset of a rel32 field
+    size_t target;   // Instruction index it must reach
+} JitFixup;
+
+// --- Runtime helpers called from generated code ---
+static int jit_input(Machine* machine) {
+    if (machine->input_pos < machine->input_len)
+        return (unsigned char)machine->input[machine->input_pos++];
+    return Machine_read_input(machine);
+}
+
+static void jit_output(Machine* machine, int value) {
+    if (machine->output_buffer_pos == machine->output_buffer_size)
+        Machine_flush_output(machine);
+    machine->output_buffer[machine->output_buffer_pos++] = (char)value;
+}
+
+// Charges the instructions counted down from r15, whose value is passed in
+// remaining, and returns nonzero when the run should stop. resume is the
+// instruction the run continues at if it is stopped here.
+static int jit_poll(Machine* machine, int remaining, unsigned int resume) {
+    machine->charged += (unsigned long long)(POLL_QUANTUM - remaining);
+    if (Machine_poll(machine) == BF_OK)
+        return 0;
+    machine->pc = resume;
+    return 1;
+}
+
+// Returns the new head position, or -1 if the run was stopped while the
+// scan at pc could not find a zero cell. Each failed lap is charged a
+// quantum, as in the interpreters.
+static int jit_scan(Machine* machine, int position, int stride, unsigned int pc) {
+    machine->tape.position = position;
+    while (!Tape_scan(&machine->tape, stride))
+        if (jit_poll(machine, 0, pc))
+            return -1;
+    return machine->tape.position;
+}
+
+// --- Code emission ---
+static void jit_emit(JitBuffer* buf, const void* bytes, size_t count) {
+    if (buf->failed)
+        return;
+    if (buf->length + count > buf->capacity) {
+        size_t new_capacity = buf->capacity ? buf->capacity * 2 : 4096;
+        while (new_capacity < buf->length + count)
+            new_capacity *= 2;
+        unsigned char* data = (unsigned char*)realloc(buf->data, new_capacity);
+        if (!data) {
+            buf->failed = 1;
+            return;
+        }
+        buf->data = data;
+        buf->capacity = new_capacity;
+    }
+    memcpy(buf->data + buf->length, bytes, count);
+    buf->length += count;
+}
+
+#define EMIT(buf, ...) do { \
+        static const unsigned char bytes_[] = { __VA_ARGS__ }; \
+        jit_emit((buf), bytes_, sizeof(bytes_)); \
+    } while (0)
+
+static void jit_emit_u32(JitBuffer* buf, uint32_t value) {
+    unsigned char bytes[4] = { (unsigned char)value, (unsigned char)(value >> 8),
+                               (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+    jit_emit(buf, bytes, sizeof(bytes));
+}
+
+static void jit_emit_u8(JitBuffer* buf, unsigned char value) {
+    jit_emit(buf, &value, 1);
+}
+
+// mov rax, helper; call rax
+static void jit_emit_call(JitBuffer* buf, void* helper) {
+    uint64_t address = (uint64_t)(uintptr_t)helper;
+    EMIT(buf, 0x48, 0xB8);
+    jit_emit_u32(buf, (uint32_t)address);
+    jit_emit_u32(buf, (uint32_t)(address >> 32));
+    EMIT(buf, 0xFF, 0xD0);
+}
+
+// Where an instruction finds its cell: [r12 + r13 * size + disp] for the
+// head, or for an offset a loop guard has proven in range, and
+// [r12 + rcx * size] once a wrapped address has been computed into ecx.
+typedef struct {
+    int width;
+    int wrapped;
+    int32_t disp;
+} JitCell;
+
+// Emits an instruction with a cell memory operand: the operand-size prefix
+// if requested, REX.B (plus REX.X for r13), the opcode, then ModRM with reg,
+// the SIB byte and the displacement, if any.
+static void jit_emit_cell_insn(JitBuffer* buf, JitCell cell, int size_prefix,
+                               const unsigned char* opcode, size_t opcode_len, unsigned char reg) {
+    unsigned char bytes[12];
+    size_t count = 0;
+    if (size_prefix)
+        bytes[count++] = 0x66;
+    bytes[count++] = cell.wrapped ? 0x41 : 0x43;
+    memcpy(bytes + count, opcode, opcode_len);
+    count += opcode_len;
+    bytes[count++] = (unsigned char)((cell.disp ? 0x80 : 0x00) | reg << 3 | 0x04);
+    bytes[count++] = (unsigned char)(cell.width << 6 | (cell.wrapped ? 0x0C : 0x2C));
+    if (cell.disp) {
+        uint32_t disp = (uint32_t)cell.disp;
+        for (int i = 0; i < 4; i++)
+            bytes[count++] = (unsigned char)(disp >> (8 * i));
+    }
+    jit_emit(buf, bytes, count);
+}
+
+// Emits op8 on 8-bit tapes or op otherwise, with the operand-size prefix
+// for 16-bit cells, so the instruction works on the whole cell.
+static void jit_emit_cell_op(JitBuffer* buf, JitCell cell, unsigned char op8, unsigned char op, unsigned char reg) {
+    unsigned char opcode = cell.width == CELL_8BIT ? op8 : op;
+    jit_emit_cell_insn(buf, cell, cell.width == CELL_16BIT, &opcode, 1, reg);
+}
+
+// Emits a cell-sized immediate.
+static void jit_emit_cell_imm(JitBuffer* buf, int width, uint32_t value) {
+    unsigned char bytes[4] = { (unsigned char)value, (unsigned char)(value >> 8),
+                               (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+    jit_emit(buf, bytes, (size_t)1 << width);
+}
+
+// Loads the cell zero-extended into the 32-bit register reg: movzx from a
+// byte or word, or a plain mov for 32-bit cells.
+static void jit_emit_cell_load(JitBuffer* buf, JitCell cell, unsigned char reg) {
+    static const unsigned char MOVZX8[] = { 0x0F, 0xB6 };
+    static const unsigned char MOVZX16[] = { 0x0F, 0xB7 };
+    static const unsigned char MOV32[] = { 0x8B };
+    if (cell.width == CELL_32BIT)
+        jit_emit_cell_insn(buf, cell, 0, MOV32, sizeof(MOV32), reg);
+    else
+        jit_emit_cell_insn(buf, cell, 0, cell.width == CELL_16BIT ? MOVZX16 : MOVZX8, 2, reg);
+}
+
+// First argument register = r14 (the Machine)
+static void jit_emit_arg_machine(JitBuffer* buf) {
+#ifdef _WIN32
+    EMIT(buf, 0x4C, 0x89, 0xF1); // mov rcx, r14
+#else
+    EMIT(buf, 0x4C, 0x89, 0xF7); // mov rdi, r14
+#endif
+}
+
+// State shared by the emitters below while one program is translated.
+typedef struct {
+    JitBuffer* buf;
+    const Program* program;
+    unsigned int mask;
+    int width;
+    size_t* offsets;      // Code offset of each instruction, then of both exits
+    JitFixup* fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    size_t stopped_index;
+} JitTranslator;
+
+static const unsigned char JB[] = { 0x0F, 0x82 };
+static const unsigned char JE[] = { 0x0F, 0x84 };
+static const unsigned char JNE[] = { 0x0F, 0x85 };
+static const unsigned char JA[] = { 0x0F, 0x87 };
+static const unsigned char JS[] = { 0x0F, 0x88 };
+static const unsigned char JG[] = { 0x0F, 0x8F };
+static const unsigned char JMP[] = { 0xE9 };
+
+// Emits a rel32 jump or conditional jump and records where it must land.
+static int jit_emit_branch(JitTranslator* t, const unsigned char* opcode, size_t opcode_len, size_t target) {
+    if (t->fixup_count == t->fixup_capacity) {
+        size_t new_capacity = t->fixup_capacity ? t->fixup_capacity * 2 : 64;
+        JitFixup* grown = (JitFixup*)realloc(t->fixups, new_capacity * sizeof(JitFixup));
+        if (!grown)
+            return 0;
+        t->fixups = grown;
+        t->fixup_capacity = new_capacity;
+    }
+    jit_emit(t->buf, opcode, opcode_len);
+    t->fixups[t->fixup_count].location = t->buf->length;
+    t->fixups[t->fixup_count].target = target;
+    t->fixup_count++;
+    jit_emit_u32(t->buf, 0);
+    return 1;
+}
+
+// Emits a rel32 jump or conditional jump to code that is already emitted.
+static void jit_emit_jump_back(JitBuffer* buf, const unsigned char* opcode, size_t opcode_len, size_t target_offset) {
+    jit_emit(buf, opcode, opcode_len);
+    jit_emit_u32(buf, (uint32_t)(int32_t)((int64_t)target_offset - (int64_t)(buf->length + 4)));
+}
+
+static void jit_patch_rel32(JitBuffer* buf, size_t location, size_t target_offset) {
+    int32_t rel = (int32_t)((int64_t)target_offset - (int64_t)(location + 4));
+    unsigned char* p = buf->data + location;
+    p[0] = (unsigned char)rel;
+    p[1] = (unsigned char)(rel >> 8);
+    p[2] = (unsigned char)(rel >> 16);
+    p[3] = (unsigned char)(rel >> 24);
+}
+
+// Returns the operand for the cell offset cells from the head. In a guarded
+// loop copy the offset is a plain displacement; otherwise the address is
+// wrapped into ecx first.
+static JitCell jit_cell(JitTranslator* t, int offset, int guarded) {
+    JitCell cell = { t->width, 0, 0 };
+    if (offset == 0)
+        return cell;
+    if (guarded) {
+        cell.disp = (int32_t)(offset * (1 << t->width));
+        return cell;
+    }
+    EMIT(t->buf, 0x41, 0x8D, 0x8D);          // lea ecx, [r13+disp32]
+    jit_emit_u32(t->buf, (uint32_t)offset);
+    EMIT(t->buf, 0x81, 0xE1);                // and ecx, mask
+    jit_emit_u32(t->buf, t->mask);
+    cell.wrapped = 1;
+    return cell;
+}
+
+// Emits the closing bracket of the loop opening at open: falls through to
+// exit_index when the cell is zero, else jumps back to body. Taken back-edges
+// subtract the loop's length in bytecode instructions from r15 and poll when
+// it runs out; a run stopped there resumes at open.
+static int jit_emit_back_edge(JitTranslator* t, size_t exit_index, size_t body, size_t open, size_t weight) {
+    JitBuffer* buf = t->buf;
+    const JitCell head = { t->width, 0, 0 };
+    int ok;
+    jit_emit_cell_op(buf, head, 0x80, 0x83, 7);  // cmp [cell], imm8 0
+    jit_emit_u8(buf, 0);
+    ok = jit_emit_branch(t, JE, sizeof(JE), exit_index);
+    EMIT(buf, 0x41, 0x81, 0xEF);                 // sub r15d, weight
+    jit_emit_u32(buf, (uint32_t)weight);
+    jit_emit_jump_back(buf, JG, sizeof(JG), body);
+#ifdef _WIN32
+    EMIT(buf, 0x44, 0x89, 0xFA);                 // mov edx, r15d
+    EMIT(buf, 0x41, 0xB8);                       // mov r8d, open
+#else
+    EMIT(buf, 0x44, 0x89, 0xFE);                 // mov esi, r15d
+    EMIT(buf, 0xBA);                             // mov edx, open
+#endif
+    jit_emit_u32(buf, (uint32_t)open);
+    jit_emit_arg_machine(buf);
+    jit_emit_call(buf, (void*)jit_poll);
+    EMIT(buf, 0x85, 0xC0);                       // test eax, eax
+    ok = ok && jit_emit_branch(t, JNE, sizeof(JNE), t->stopped_index);
+    EMIT(buf, 0x41, 0xBF);                       // mov r15d, POLL_QUANTUM
+    jit_emit_u32(buf, POLL_QUANTUM);
+    jit_emit_jump_back(buf, JMP, sizeof(JMP), body);
+    return ok;
+}
+
+// Emits the instruction at pc. guarded is set inside the checked copy of a
+// flat loop, where offsets need no wrapping.
+static int jit_emit_instruction(JitTranslator* t, size_t pc, int guarded) {
+    JitBuffer* buf = t->buf;
+    const Instruction* ins = &t->program->code[pc];
+    const JitCell head = { t->width, 0, 0 };
+    JitCell cell;
+
+    switch (ins->op) {
+        case OP_ADD:
+            cell = jit_cell(t, ins->offset, guarded);
+            jit_emit_cell_op(buf, cell, 0x80, 0x81, 0);  // add [cell], imm
+            jit_emit_cell_imm(buf, t->width, (uint32_t)ins->arg);
+            return 1;
+        case OP_MOVE:
+            EMIT(buf, 0x41, 0x81, 0xC5);       // add r13d, imm32
+            jit_emit_u32(buf, (uint32_t)ins->arg);
+            EMIT(buf, 0x41, 0x81, 0xE5);       // and r13d, mask
+            jit_emit_u32(buf, t->mask);
+            return 1;
+        case OP_IN:
+            jit_emit_arg_machine(buf);
+            jit_emit_call(buf, (void*)jit_input);
+            cell = jit_cell(t, ins->offset, guarded);
+            jit_emit_cell_op(buf, cell, 0x88, 0x89, 0);  // mov [cell], al/ax/eax
+            return 1;
+        case OP_OUT:
+            cell = jit_cell(t, ins->offset, guarded);
+#ifdef _WIN32
+            jit_emit_cell_load(buf, cell, 2);            // edx = cell
+#else
+            jit_emit_cell_load(buf, cell, 6);            // esi = cell
+#endif
+            jit_emit_arg_machine(buf);
+            jit_emit_call(buf, (void*)jit_output);
+            return 1;
+        case OP_JZ:
+            jit_emit_cell_op(buf, head, 0x80, 0x83, 7);  // cmp [cell], imm8 0
+            jit_emit_u8(buf, 0);
+            return jit_emit_branch(t, JE, sizeof(JE), (size_t)ins->arg);
+        case OP_JNZ:
+            return jit_emit_back_edge(t, pc + 1, t->offsets[ins->arg], (size_t)ins->arg - 1, pc + 1 - (size_t)ins->arg);
+        case OP_CLEAR:
+            cell = jit_cell(t, ins->offset, guarded);
+            jit_emit_cell_op(buf, cell, 0xC6, 0xC7, 0);  // mov [cell], 0
+            jit_emit_cell_imm(buf, t->width, 0);
+            return 1;
+        case OP_MULADD:
+            jit_emit_cell_load(buf, head, 0);            // eax = cell
+            EMIT(buf, 0x69, 0xC0);                       // imul eax, eax, imm32
+            jit_emit_u32(buf, (uint32_t)ins->arg);
+            cell = jit_cell(t, ins->offset, 0);
+            jit_emit_cell_op(buf, cell, 0x00, 0x01, 0);  // add [cell], al/ax/eax
+            return 1;
+        case OP_SCAN:
+#ifdef _WIN32
+            EMIT(buf, 0x44, 0x89, 0xEA);       // mov edx, r13d
+            EMIT(buf, 0x41, 0xB8);             // mov r8d, imm32
+            jit_emit_u32(buf, (uint32_t)ins->arg);
+            EMIT(buf, 0x41, 0xB9);             // mov r9d, pc
+#else
+            EMIT(buf, 0x44, 0x89, 0xEE);       // mov esi, r13d
+            EMIT(buf, 0xBA);                   // mov edx, imm32
+            jit_emit_u32(buf, (uint32_t)ins->arg);
+            EMIT(buf, 0xB9);                   // mov ecx, pc
+#endif
+            jit_emit_u32(buf, (uint32_t)pc);
+            jit_emit_arg_machine(buf);
+            jit_emit_call(buf, (void*)jit_scan);
+            EMIT(buf, 0x85, 0xC0);             // test eax, eax
+            if (!jit_emit_branch(t, JS, sizeof(JS), t->stopped_index))
+                return 0;
+            EMIT(buf, 0x41, 0x89, 0xC5);       // mov r13d, eax
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Returns 1 if the loop opening at pc is flat: its body is ADD, IN, OUT and
+// CLEAR only and reaches at least one cell besides the head, which is what
+// Program_compile leaves of a balanced loop after folding its moves. low and
+// high receive the extreme offsets, counting the head at offset 0.
+static int jit_flat_loop(const Program* program, size_t pc, int* low, int* high) {
+    const size_t close = (size_t)program->code[pc].arg - 1;
+    int moved = 0;
+    *low = *high = 0;
+    for (size_t i = pc + 1; i < close; i++) {
+        const Instruction* ins = &program->code[i];
+        if (ins->op != OP_ADD && ins->op != OP_IN && ins->op != OP_OUT && ins->op != OP_CLEAR)
+            return 0;
+        if (ins->offset < *low)
+            *low = ins->offset;
+        if (ins->offset > *high)
+            *high = ins->offset;
+        moved |= ins->offset != 0;
+    }
+    return moved;
+}
+
+static int jit_emit_loop_copy(JitTranslator* t, size_t open, size_t close, int guarded) {
+    const JitCell head = { t->width, 0, 0 };
+    size_t body;
+    int ok;
+    jit_emit_cell_op(t->buf, head, 0x80, 0x83, 7); // cmp [cell], imm8 0
+    jit_emit_u8(t->buf, 0);
+    ok = jit_emit_branch(t, JE, sizeof(JE), close + 1);
+    body = t->buf->length;
+    for (size_t i = open + 1; ok && i < close; i++)
+        ok = jit_emit_instruction(t, i, guarded);
+    return ok && jit_emit_back_edge(t, close + 1, body, open, close - open);
+}
+
+// Emits a flat loop twice. A guard on entry checks once that every cell the
+// body touches lies inside the tape and then runs the first copy, which
+// addresses its cells by displacement with no wrapping at all; otherwise the
+// second copy runs with each address wrapped, so results are always exact.
+static int jit_emit_guarded_loop(JitTranslator* t, size_t open, int low, int high) {
+    JitBuffer* buf = t->buf;
+    const size_t close = (size_t)t->program->code[open].arg - 1;
+    size_t guards[2];
+    int guard_count = 0, ok = 1;
+
+    if ((unsigned int)(high - low) <= t->mask) {
+        EMIT(buf, 0x41, 0x81, 0xFD);             // cmp r13d, -low
+        jit_emit_u32(buf, (uint32_t)-low);
+        jit_emit(buf, JB, sizeof(JB));
+        guards[guard_count++] = buf->length;
+        jit_emit_u32(buf, 0);
+        EMIT(buf, 0x41, 0x81, 0xFD);             // cmp r13d, mask - high
+        jit_emit_u32(buf, t->mask - (unsigned int)high);
+        jit_emit(buf, JA, sizeof(JA));
+        guards[guard_count++] = buf->length;
+        jit_emit_u32(buf, 0);
+        ok = jit_emit_loop_copy(t, open, close, 1);
+    }
+    size_t wrapped = buf->length;
+    ok = ok && jit_emit_loop_copy(t, open, close, 0);
+    for (int i = 0; ok && !buf->failed && i < guard_count; i++)
+        jit_patch_rel32(buf, guards[i], wrapped);
+    return ok;
+}
+
+// Translates the program into buf for the given tape. Its mask is baked into
+// the code as an immediate and every cell access is emitted at its width, so
+// the generated code never checks either. Instruction index program->length
+// is the normal exit and program->length + 1 the stopped exit. The code
+// jumps from the prologue to start, which must be 0, the end, an opening
+// bracket or a scan: the places a stopped run resumes at. A run continuing
+// after an evaluated prefix may also start at any instruction outside loops.
+static int jit_translate(JitBuffer* buf, const Program* program, const Tape* tape, size_t start) {
+    const size_t exit_index = program->length, stopped_index = program->length + 1;
+    const uint32_t position_offset = (uint32_t)(offsetof(Machine, tape) + offsetof(Tape, position));
+    JitTranslator t = { buf, program, tape->mask, tape->cell_width, NULL, NULL, 0, 0, stopped_index };
+    t.offsets = (size_t*)malloc((program->length + 2) * sizeof(size_t));
+    int ok = t.offsets != NULL;
+
+    // Prologue: save callee-saved registers, keep the stack 16-byte aligned
+    // (plus shadow space on Win64) and load the state registers.
+    EMIT(buf, 0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57);
+#ifdef _WIN32
+    EMIT(buf, 0x48, 0x83, 0xEC, 0x28); // sub rsp, 40
+    EMIT(buf, 0x49, 0x89, 0xCE);       // mov r14, rcx
+    EMIT(buf, 0x49, 0x89, 0xD4);       // mov r12, rdx
+    EMIT(buf, 0x45, 0x89, 0xC5);       // mov r13d, r8d
+#else
+    EMIT(buf, 0x48, 0x83, 0xEC, 0x08); // sub rsp, 8
+    EMIT(buf, 0x49, 0x89, 0xFE);       // mov r14, rdi
+    EMIT(buf, 0x49, 0x89, 0xF4);       // mov r12, rsi
+    EMIT(buf, 0x41, 0x89, 0xD5);       // mov r13d, edx
+#endif
+    EMIT(buf, 0x41, 0xBF);             // mov r15d, POLL_QUANTUM
+    jit_emit_u32(buf, POLL_QUANTUM);
+    if (start != 0)
+        ok = ok && jit_emit_branch(&t, JMP, sizeof(JMP), start);
+
+    for (size_t pc = 0; ok && pc < program->length; pc++) {
+        int low, high;
+        t.offsets[pc] = buf->length;
+        if (program->code[pc].op == OP_JZ && jit_flat_loop(program, pc, &low, &high)) {
+            // Nothing branches into a loop body, so its instructions need no offsets.
+            ok = jit_emit_guarded_loop(&t, pc, low, high);
+            pc = (size_t)program->code[pc].arg - 1;
+        } else
+            ok = jit_emit_instruction(&t, pc, 0);
+    }
+
+    if (ok) {
+        t.offsets[exit_index] = buf->length;
+        EMIT(buf, 0x31, 0xC0);                   // xor eax, eax
+        EMIT(buf, 0xEB, 0x05);                   // jmp +5 (over the stopped exit)
+        t.offsets[stopped_index] = buf->length;
+        EMIT(buf, 0xB8);                         // mov eax, BF_STOPPED
+        jit_emit_u32(buf, BF_STOPPED);
+        EMIT(buf, 0x45, 0x89, 0xAE);             // mov [r14+disp32], r13d
+        jit_emit_u32(buf, position_offset);
+#ifdef _WIN32
+        EMIT(buf, 0x48, 0x83, 0xC4, 0x28);       // add rsp, 40
+#else
+        EMIT(buf, 0x48, 0x83, 0xC4, 0x08);       // add rsp, 8
+#endif
+        EMIT(buf, 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B, 0xC3);
+        ok = !buf->failed;
+    }
+    for (size_t i = 0; ok && i < t.fixup_count; i++)
+        jit_patch_rel32(buf, t.fixups[i].location, t.offsets[t.fixups[i].target]);
+
+    free(t.fixups);
+    free(t.offsets);
+    return ok && !buf->failed;
+}
+
+// --- Executable memory ---
+static void* jit_map_code(const unsigned char* code, size_t length) {
+#ifdef _WIN32
+    void* memory = VirtualAlloc(NULL, length, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    DWORD old_protect;
+    if (!memory)
+        return NULL;
+    memcpy(memory, code, length);
+    if (!VirtualProtect(memory, length, PAGE_EXECUTE_READ, &old_protect)) {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        return NULL;
+    }
+    FlushInstructionCache(GetCurrentProcess(), memory, length);
+    return memory;
+#else
+    void* memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return NULL;
+    memcpy(memory, code, length);
+    if (mprotect(memory, length, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, length);
+        return NULL;
+    }
+    return memory;
+#endif
+}
+
+static void jit_unmap_code(void* memory, size_t length) {
+#ifdef _WIN32
+    (void)length;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, length);
+#endif
+}
+
+int Machine_run_jit(Machine* machine, const Program* program) {
+    JitBuffer buf = { NULL, 0, 0, 0 };
+    void* memory = NULL;
+
+    if (jit_translate(&buf, program, &machine->tape, machine->pc))
+        memory = jit_map_code(buf.data, buf.length);
+    free(buf.data);
+    if (!memory) {
+        DebugPrintInterpreter("Machine_run_jit: Code generation failed, falling back to the interpreter.\n");
+        return Machine_run_threaded(machine, program);
+    }
+
+    JitEntry entry = (JitEntry)memory;
+    int status = entry(machine, machine->tape.tape, (unsigned int)machine->tape.position);
+    Machine_flush_output(machine);
+    jit_unmap_code(memory, buf.length);
+    // The stopped exit does not know why the run stopped; Machine_poll does,
+    // and the helper that saw it left the resume point in machine->pc.
+    if (status == BF_STOPPED)
+        status = machine->stop_status;
+    else
+        machine->pc = program->length;
+    if (status != BF_OK)
+        DebugPrintInterpreter("Machine_run_jit: Stopped with status %d.\n", status);
+    return status;
+}
+
+#else // !BF_JIT_AVAILABLE
+
+int Machine_run_jit(Machine* machine, const Program* program) {
+    DebugPrintInterpreter("Machine_run_jit: No JIT for this architecture, falling back to the interpreter.\n");
+    return Machine_run_threaded(machine, program);
+}
+
+#endif // BF_JIT_AVAILABLE
@@ -0,0 +1,387 @@
+// Define to enable POSIX features like read. Must be before any system headers.
+#define _POSIX_C_SOURCE 200809L
+
+#include "bfcli.h"
+#include "bfengine.h"
+
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#define read _read
+#define STDIN_FILENO 0
+#else
+#include <unistd.h>
+#endif
+
+// Headless command-line runner: executes a Brainfuck program with the same
+// engine as the GUI, streaming stdin to ',' and '.' to stdout.
+
+// Exit codes
+#define EXIT_RUN_OK         0
+#define EXIT_USAGE          64
+#define EXIT_BAD_PROGRAM    65
+#define EXIT_NO_INPUT       66
+#define EXIT_SOFTWARE       70
+#define EXIT_IO_ERROR       74
+#define EXIT_STEP_LIMIT     122
+#define EXIT_OUTPUT_LIMIT   123
+#define EXIT_TIME_LIMIT     124 // As timeout(1)
+#define EXIT_INTERRUPTED    130
+
+#define RUN_OUTPUT_SIZE     (64 * 1024)
+#define RUN_INPUT_SIZE      (64 * 1024)
+#define RUN_TRACE_RECORDS   (1 << 20) // Default --trace-records
+
+static volatile int g_running = 1;
+static int g_debug = 0;
+static int g_output_failed = 0;
+
+void DebugPrintInterpreter(const char* format, ...) {
+    if (!g_debug)
+        return;
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+static void HandleInterrupt(int signal_number) {
+    (void)signal_number;
+    g_running = 0;
+}
+
+static void WriteOutput(void* context, const char* data, size_t length) {
+    FILE* file = (FILE*)context;
+    if (fwrite(data, 1, length, file) != length)
+        g_output_failed = 1;
+}
+
+// Reads whatever is available on stdin so interactive programs see each
+// line as soon as it is entered.
+static size_t ReadInput(void* context, const char** data) {
+    char* buffer = (char*)context;
+    int count = (int)read(STDIN_FILENO, buffer, RUN_INPUT_SIZE);
+    *data = buffer;
+    return count > 0 ? (size_t)count : 0;
+}
+
+static int ParseEngine(const char* name) {
+    if (strcmp(name, "switch") == 0) return ENGINE_SWITCH;
+    if (strcmp(name, "threaded") == 0) return ENGINE_THREADED;
+    if (strcmp(name, "jit") == 0) return ENGINE_JIT;
+    return -1;
+}
+
+static int ParseTapeMode(const char* name) {
+    if (strcmp(name, "wrap") == 0) return TAPE_WRAP;
+    if (strcmp(name, "large") == 0) return TAPE_LARGE;
+    return -1;
+}
+
+static int ParseCellWidth(const char* bits) {
+    if (strcmp(bits, "8") == 0) return CELL_8BIT;
+    if (strcmp(bits, "16") == 0) return CELL_16BIT;
+    if (strcmp(bits, "32") == 0) return CELL_32BIT;
+    return -1;
+}
+
+// Parses a nonnegative decimal count into *value. Returns 0 if text is not one.
+static int ParseCount(const char* text, unsigned long long* value) {
+    char* end;
+    if (text[0] < '0' || text[0] > '9')
+        return 0;
+    *value = strtoull(text, &end, 10);
+    return *end == '\0';
+}
+
+// Writes the checkpoint next to path and renames it into place, so a crash
+// while saving leaves the previous checkpoint intact.
+static int SaveCheckpoint(const char* path, const Machine* machine, const Program* program) {
+    char* temp_path = (char*)malloc(strlen(path) + 5);
+    FILE* file;
+    int status = BF_ERR_IO;
+
+    if (!temp_path)
+        return BF_ERR_NO_MEMORY;
+    sprintf(temp_path, "%s.tmp", path);
+    file = fopen(temp_path, "wb");
+    if (file) {
+        status = Machine_save_checkpoint(machine, program, file);
+        if (fclose(file) != 0)
+            status = BF_ERR_IO;
+#ifdef _WIN32
+        // rename does not replace an existing file on Windows.
+        if (status == BF_OK)
+            remove(path);
+#endif
+        if (status == BF_OK && rename(temp_path, path) != 0)
+            status = BF_ERR_IO;
+        if (status != BF_OK)
+            remove(temp_path);
+    }
+    if (status != BF_OK)
+        fprintf(stderr, "bfrun: cannot write checkpoint to %s\n", path);
+    free(temp_path);
+    return status;
+}
+
+static void SaveAutoCheckpoint(void* context, Machine* machine, const Program* program) {
+    SaveCheckpoint((const char*)context, machine, program);
+}
+
+static void PrintUsage(FILE* file) {
+    fprintf(file,
+        "Usage: bfrun [options] PROGRAM\n"
+        "Runs a Brainfuck program headless, reading stdin and writing stdout.\n"
+        "\n"
+        "Options:\n"
+        "  -e, --engine NAME   execution engine: switch, threaded or jit (default: jit)\n"
+        "  -t, --tape MODE     tape layout: wrap (65536 cells) or large (grows on demand)\n"
+        "  -w, --cell-width N  cell width in bits: 8, 16 or 32 (default: 8)\n"
+        "  -c, --emit-c        write the program as C source to stdout instead of running it\n"
+        "  -d, --debug         print interpreter debug messages to stderr\n"
+        "  --trace FILE        record the last steps of the run with the reference\n"
+        "                      interpreter and write them to FILE afterwards\n"
+        "  --trace-records N   steps kept for --trace (default: 1048576)\n"
+        "  --checkpoint FILE   save the run's state to FILE if it is interrupted or\n"
+        "                      stopped by a limit\n"
+        "  --checkpoint-every SECONDS\n"
+        "                      also save it every SECONDS seconds\n"
+        "  --resume FILE       continue from a checkpoint; stdin must be the same input\n"
+        "                      from its start, and the bytes already read are skipped\n"
+        "  -h, --help          show this help\n"
+        "\n"
+        "Limits (0, the default, means none):\n"
+        "  --max-steps N       stop after about N instructions\n"
+        "  --timeout MS        stop after MS milliseconds\n"
+        "  --max-output BYTES  stop once BYTES bytes have been written\n"
+        "\n"
+        "Exit status: 0 success, 64 usage error, 65 mismatched brackets,\n"
+        "66 program not readable, 70 out of memory, 74 output error,\n"
+        "122 step limit, 123 output limit, 124 timeout, 130 interrupted.\n");
+}
+
+int main(int argc, char** argv) {
+    const char* program_path = NULL;
+    int engine = ENGINE_JIT;
+    int tape_mode = TAPE_WRAP;
+    int cell_width = CELL_8BIT;
+    int emit_c = 0;
+    unsigned long long step_limit = 0, output_limit = 0, time_limit_ms = 0;
+    const char* trace_path = NULL;
+    const char* checkpoint_path = NULL;
+    const char* resume_path = NULL;
+    unsigned long long checkpoint_seconds = 0;
+    unsigned long long trace_records = RUN_TRACE_RECORDS;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-e") == 0 || strcmp(arg, "--engine") == 0) {
+            if (++i >= argc || (engine = ParseEngine(argv[i])) < 0) {
+                fprintf(stderr, "bfrun: --engine needs one of switch, threaded, jit\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-t") == 0 || strcmp(arg, "--tape") == 0) {
+            if (++i >= argc || (tape_mode = ParseTapeMode(argv[i])) < 0) {
+                fprintf(stderr, "bfrun: --tape needs one of wrap, large\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-w") == 0 || strcmp(arg, "--cell-width") == 0) {
+            if (++i >= argc || (cell_width = ParseCellWidth(argv[i])) < 0) {
+                fprintf(stderr, "bfrun: --cell-width needs one of 8, 16, 32\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--max-steps") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &step_limit)) {
+                fprintf(stderr, "bfrun: --max-steps needs a number of instructions\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--timeout") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &time_limit_ms) || time_limit_ms > 0xFFFFFFFFu) {
+                fprintf(stderr, "bfrun: --timeout needs a number of milliseconds\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--max-output") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &output_limit)) {
+                fprintf(stderr, "bfrun: --max-output needs a number of bytes\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--trace") == 0) {
+            if (++i >= argc) {
+                fprintf(stderr, "bfrun: --trace needs a file name\n");
+                return EXIT_USAGE;
+            }
+            trace_path = argv[i];
+        } else if (strcmp(arg, "--trace-records") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &trace_records) || trace_records == 0 || trace_records > (1ULL << 31)) {
+                fprintf(stderr, "bfrun: --trace-records needs a count from 1 to 2147483648\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "--checkpoint") == 0 || strcmp(arg, "--resume") == 0) {
+            if (++i >= argc) {
+                fprintf(stderr, "bfrun: %s needs a file name\n", arg);
+                return EXIT_USAGE;
+            }
+            if (arg[2] == 'c')
+                checkpoint_path = argv[i];
+            else
+                resume_path = argv[i];
+        } else if (strcmp(arg, "--checkpoint-every") == 0) {
+            if (++i >= argc || !ParseCount(argv[i], &checkpoint_seconds) || checkpoint_seconds == 0 || checkpoint_seconds > 0xFFFFFFFFu / 1000) {
+                fprintf(stderr, "bfrun: --checkpoint-every needs a number of seconds\n");
+                return EXIT_USAGE;
+            }
+        } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--emit-c") == 0)
+            emit_c = 1;
+        else if (strcmp(arg, "-d") == 0 || strcmp(arg, "--debug") == 0)
+            g_debug = 1;
+        else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            PrintUsage(stdout);
+            return EXIT_RUN_OK;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            fprintf(stderr, "bfrun: unknown option %s\n", arg);
+            PrintUsage(stderr);
+            return EXIT_USAGE;
+        } else if (!program_path)
+            program_path = arg;
+        else {
+            PrintUsage(stderr);
+            return EXIT_USAGE;
+        }
+    }
+    if (!program_path) {
+        PrintUsage(stderr);
+        return EXIT_USAGE;
+    }
+    if (checkpoint_seconds && !checkpoint_path) {
+        fprintf(stderr, "bfrun: --checkpoint-every needs --checkpoint\n");
+        return EXIT_USAGE;
+    }
+
+    size_t code_len;
+    char* code = ReadWholeFile(program_path, &code_len);
+    if (!code) {
+        fprintf(stderr, "bfrun: cannot read %s\n", program_path);
+        return EXIT_NO_INPUT;
+    }
+    Program program;
+    int status = Program_compile(&program, code, code_len);
+    free(code);
+    if (status == BF_ERR_MISMATCHED_BRACKETS) {
+        fprintf(stderr, "bfrun: %s: mismatched brackets\n", program_path);
+        return EXIT_BAD_PROGRAM;
+    } else if (status != BF_OK) {
+        fprintf(stderr, "bfrun: out of memory\n");
+        return EXIT_SOFTWARE;
+    }
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    if (emit_c) {
+        status = Program_export_c(&program, tape_mode == TAPE_LARGE ? TAPE_LARGE_SIZE : TAPE_SIZE, cell_width, stdout);
+        Program_free(&program);
+        return status == BF_OK ? EXIT_RUN_OK : EXIT_IO_ERROR;
+    }
+
+    // The Machine buffers output itself, so stdout is written unbuffered in
+    // RUN_OUTPUT_SIZE blocks.
+    setvbuf(stdout, NULL, _IONBF, 0);
+    Machine* machine = (Machine*)malloc(sizeof(Machine));
+    char* output_buffer = (char*)malloc(RUN_OUTPUT_SIZE);
+    char* input_buffer = (char*)malloc(RUN_INPUT_SIZE);
+    if (!machine || !output_buffer || !input_buffer || Machine_init(machine, tape_mode, cell_width) != BF_OK) {
+        fprintf(stderr, "bfrun: out of memory\n");
+        return EXIT_SOFTWARE;
+    }
+    machine->input_callback = ReadInput;
+    machine->input_context = input_buffer;
+    machine->output_buffer = output_buffer;
+    machine->output_buffer_size = RUN_OUTPUT_SIZE;
+    machine->output_callback = WriteOutput;
+    machine->output_context = stdout;
+    machine->running = &g_running;
+    machine->step_limit = step_limit;
+    machine->output_limit = output_limit;
+    machine->time_limit_ms = (unsigned int)time_limit_ms;
+    if (checkpoint_seconds) {
+        machine->checkpoint_interval_ms = (unsigned int)checkpoint_seconds * 1000u;
+        machine->checkpoint_callback = SaveAutoCheckpoint;
+        machine->checkpoint_context = (void*)checkpoint_path;
+    }
+
+    if (resume_path) {
+        FILE* resume_file = fopen(resume_path, "rb");
+        status = resume_file ? Machine_load_checkpoint(machine, &program, resume_file) : BF_ERR_IO;
+        if (resume_file)
+            fclose(resume_file);
+        if (status != BF_OK) {
+            if (status == BF_ERR_CHECKPOINT)
+                fprintf(stderr, "bfrun: %s is not a checkpoint of this program with this tape\n", resume_path);
+            else
+                fprintf(stderr, "bfrun: cannot resume from %s: file unreadable or input too short\n", resume_path);
+            return EXIT_NO_INPUT;
+        }
+    }
+
+    TraceRing trace = { NULL, 0, 0 };
+    if (trace_path) {
+        if (TraceRing_init(&trace, (size_t)trace_records) != BF_OK) {
+            fprintf(stderr, "bfrun: out of memory for %lu trace records\n", (unsigned long)trace_records);
+            return EXIT_SOFTWARE;
+        }
+        machine->trace = &trace;
+    }
+
+    signal(SIGINT, HandleInterrupt);
+    status = Machine_run_engine(machine, &program, engine);
+
+    // A run that ended early can be continued with --resume.
+    if (checkpoint_path && status != BF_OK && status != BF_ERR_NO_MEMORY)
+        SaveCheckpoint(checkpoint_path, machine, &program);
+
+    // The trace is written even when the run failed, which is when it is wanted.
+    if (trace_path) {
+        FILE* trace_file = fopen(trace_path, "wb");
+        if (!trace_file || TraceRing_dump(&trace, trace_file) != BF_OK) {
+            fprintf(stderr, "bfrun: cannot write trace to %s\n", trace_path);
+            g_output_failed = 1;
+        }
+        if (trace_file)
+            fclose(trace_file);
+        TraceRing_free(&trace);
+    }
+
+    Program_free(&program);
+    Machine_free(machine);
+    free(machine);
+    free(output_buffer);
+    free(input_buffer);
+
+    if (g_output_failed) {
+        fprintf(stderr, "bfrun: error writing output\n");
+        return EXIT_IO_ERROR;
+    }
+    switch (status) {
+        case BF_OK: return EXIT_RUN_OK;
+        case BF_STOPPED: return EXIT_INTERRUPTED;
+        case BF_STEP_LIMIT:
+            fprintf(stderr, "bfrun: instruction limit reached\n");
+            return EXIT_STEP_LIMIT;
+        case BF_TIME_LIMIT:
+            fprintf(stderr, "bfrun: time limit reached\n");
+            return EXIT_TIME_LIMIT;
+        case BF_OUTPUT_LIMIT:
+            fprintf(stderr, "bfrun: output limit reached\n");
+            return EXIT_OUTPUT_LIMIT;
+        default: return EXIT_SOFTWARE;
+    }
+}
@@ -0,0 +1,238 @@
+#include "bfengine.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+// Zero-cell search for scan loops such as [>], [<] and [>>>>]. On 8-bit
+// tapes, strides that divide 16 are searched a vector at a time with SSE2,
+// or AVX2 when the CPU supports it; any other stride, and any wider cell,
+// falls back to a plain loop.
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define BF_SCAN_SSE2 1
+#include <emmintrin.h>
+#if defined(__clang__) || __GNUC__ >= 5
+#define BF_SCAN_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+#define SCAN_NOT_FOUND ((size_t)-1)
+
+// Bit patterns selecting every stride-th lane of a 32-lane comparison mask,
+// starting from the lowest lane (forward) or the highest lane (backward).
+static unsigned int scan_lane_mask_forward(int stride) {
+    switch (stride) {
+        case 1: return 0xFFFFFFFFu;
+        case 2: return 0x55555555u;
+        case 4: return 0x11111111u;
+        case 8: return 0x01010101u;
+        default: return 0x00010001u;
+    }
+}
+
+static unsigned int scan_lane_mask_backward(int stride) {
+    switch (stride) {
+        case 1: return 0xFFFFFFFFu;
+        case 2: return 0xAAAAAAAAu;
+        case 4: return 0x88888888u;
+        case 8: return 0x80808080u;
+        default: return 0x80008000u;
+    }
+}
+
+// Returns the first index i in [from, to) with i = from + k * stride and
+// tape[i] == 0.
+static size_t scan_forward_scalar(const unsigned char* tape, size_t from, size_t to, int stride) {
+    for (size_t i = from; i < to; i += (size_t)stride)
+        if (tape[i] == 0)
+            return i;
+    return SCAN_NOT_FOUND;
+}
+
+// Returns the last index i in [low, from] with i = from - k * stride and
+// tape[i] == 0.
+static size_t scan_backward_scalar(const unsigned char* tape, size_t from, size_t low, int stride) {
+    if (from < low)
+        return SCAN_NOT_FOUND;
+    for (size_t i = from; ; i -= (size_t)stride) {
+        if (tape[i] == 0)
+            return i;
+        if (i < low + (size_t)stride)
+            return SCAN_NOT_FOUND;
+    }
+}
+
+#ifdef BF_SCAN_SSE2
+static size_t scan_forward_sse2(const unsigned char* tape, size_t from, size_t to, int stride) {
+    const __m128i zero = _mm_setzero_si128();
+    unsigned int lanes = scan_lane_mask_forward(stride) & 0xFFFFu;
+    size_t i = from;
+    for (; i + 16 <= to; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(tape + i));
+        unsigned int hits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)) & lanes;
+        if (hits)
+            return i + (size_t)__builtin_ctz(hits);
+    }
+    return scan_forward_scalar(tape, i, to, stride);
+}
+
+static size_t scan_backward_sse2(const unsigned char* tape, size_t from, size_t low, int stride) {
+    const __m128i zero = _mm_setzero_si128();
+    unsigned int lanes = scan_lane_mask_backward(stride) & 0xFFFFu;
+    size_t i = from;
+    for (; i >= low + 15 && i >= 15; i -= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(tape + i - 15));
+        unsigned int hits = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)) & lanes;
+        if (hits)
+            return i - 15 + (size_t)(31 - __builtin_clz(hits));
+        if (i < low + 16)
+            return SCAN_NOT_FOUND;
+    }
+    return scan_backward_scalar(tape, i, low, stride);
+}
+#endif
+
+#ifdef BF_SCAN_AVX2
+__attribute__((target("avx2")))
+static size_t scan_forward_avx2(const unsigned char* tape, size_t from, size_t to, int stride) {
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned int lanes = scan_lane_mask_forward(stride);
+    size_t i = from;
+    for (; i + 32 <= to; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(tape + i));
+        unsigned int hits = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero)) & lanes;
+        if (hits)
+            return i + (size_t)__builtin_ctz(hits);
+    }
+    return scan_forward_sse2(tape, i, to, stride);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_backward_avx2(const unsigned char* tape, size_t from, size_t low, int stride) {
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned int lanes = scan_lane_mask_backward(stride);
+    size_t i = from;
+    for (; i >= low + 31 && i >= 31; i -= 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*)(tape + i - 31));
+        unsigned int hits = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero)) & lanes;
+        if (hits)
+            return i - 31 + (size_t)(31 - __builtin_clz(hits));
+        if (i < low + 32)
+            return SCAN_NOT_FOUND;
+    }
+    return scan_backward_sse2(tape, i, low, stride);
+}
+#endif
+
+typedef size_t (*ScanFunc)(const unsigned char* tape, size_t from, size_t to, int stride);
+
+typedef struct {
+    ScanFunc forward;
+    ScanFunc backward;
+} ScanImpl;
+
+static const ScanImpl scan_impl_scalar = { scan_forward_scalar, scan_backward_scalar };
+#ifdef BF_SCAN_SSE2
+static const ScanImpl scan_impl_sse2 = { scan_forward_sse2, scan_backward_sse2 };
+#endif
+#ifdef BF_SCAN_AVX2
+static const ScanImpl scan_impl_avx2 = { scan_forward_avx2, scan_backward_avx2 };
+#endif
+
+// The chosen pair is published as one pointer with release/acquire ordering.
+// Threads that race on the first scan may each pick it, but they all pick the
+// same pair, and no thread can see half of it.
+static _Atomic(const ScanImpl*) scan_impl = NULL;
+
+// Returns the widest search the CPU supports.
+static const ScanImpl* scan_get_impl(void) {
+    const ScanImpl* impl = atomic_load_explicit(&scan_impl, memory_order_acquire);
+    if (impl)
+        return impl;
+    impl = &scan_impl_scalar;
+#ifdef BF_SCAN_SSE2
+    impl = &scan_impl_sse2;
+#endif
+#ifdef BF_SCAN_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        impl = &scan_impl_avx2;
+#endif
+    atomic_store_explicit(&scan_impl, impl, memory_order_release);
+    return impl;
+}
+
+// Walks the whole cycle of a wide-cell tape one cell at a time.
+#define SCAN_CELLS(name, type)                                      \
+    static int name(Tape* tape, int stride) {                       \
+        const type* cells = (const type*)tape->tape;                \
+        const size_t size = Tape_size(tape);                        \
+        size_t pos = (size_t)tape->position;                        \
+        for (size_t k = 0; k < size; k++) {                         \
+            size_t i = (pos + k * (size_t)stride) & tape->mask;     \
+            if (cells[i] == 0) {                                    \
+                tape->position = (int)i;                            \
+                return 1;                                           \
+            }                                                       \
+            if (k > 0 && i == pos)                                  \
+                break;                                              \
+        }                                                           \
+        return 0;                                                   \
+    }
+
+SCAN_CELLS(scan_cells_16, uint16_t)
+SCAN_CELLS(scan_cells_32, uint32_t)
+
+#undef SCAN_CELLS
+
+// Moves the head by stride until it reaches a zero cell, wrapping around the
+// tape like Tape_move. Returns 0 and leaves the head in place if every cell
+// the loop would visit is nonzero, in which case the loop never terminates.
+int Tape_scan(Tape* tape, int stride) {
+    const unsigned char* cells = tape->tape;
+    const size_t size = Tape_size(tape);
+    size_t pos = (size_t)tape->position;
+    size_t found;
+
+    if (tape->cell_width == CELL_16BIT)
+        return scan_cells_16(tape, stride);
+    if (tape->cell_width == CELL_32BIT)
+        return scan_cells_32(tape, stride);
+    if (cells[pos] == 0)
+        return 1;
+
+    int step = stride < 0 ? -stride : stride;
+    if (16 % step != 0) {
+        // Strides that do not divide the vector width may visit several
+        // residues per lap, so walk the whole cycle one cell at a time.
+        for (size_t k = 1; k < size; k++) {
+            size_t i = (pos + k * (size_t)stride) & tape->mask;
+            if (cells[i] == 0) {
+                tape->position = (int)i;
+                return 1;
+            }
+            if (i == pos)
+                break;
+        }
+        return 0;
+    }
+
+    const ScanImpl* impl = scan_get_impl();
+    // step divides the tape size, so the wrapped search continues in the same
+    // residue class and one lap is at most two contiguous ranges.
+    if (stride > 0) {
+        found = impl->forward(cells, pos, size, step);
+        if (found == SCAN_NOT_FOUND)
+            found = impl->forward(cells, pos % (size_t)step, pos, step);
+    } else {
+        found = impl->backward(cells, pos, 0, step);
+        if (found == SCAN_NOT_FOUND)
+            found = impl->backward(cells, size - (size_t)step + pos % (size_t)step, pos + 1, step);
+    }
+    if (found == SCAN_NOT_FOUND)
+        return 0;
+    tape->position = (int)found;
+    return 1;
+}
@@ -0,0 +1,404 @@
+#include "bf.h"
+
+// --- Output View ---
+// A read-only, scrollable text pane for program output. Text is kept in
+// fixed-size chunks that are never moved, with a separate index of line
+// start offsets, so appending costs O(1) per byte however large the output
+// grows. Painting only formats the lines that are on screen. Lines end at
+// \n; a \r before it is not drawn, and \r\n is only produced for
+// WM_GETTEXT, which is what the clipboard wants.
+
+#define OUTPUT_VIEW_CHUNK_SIZE  (64 * 1024)
+#define OUTPUT_VIEW_MAX_COLUMNS 1024 // Longest line segment drawn at once
+#define OUTPUT_VIEW_WHEEL_LINES 3
+
+typedef struct {
+    char** chunks;
+    size_t chunk_count;
+    size_t chunk_capacity;
+    size_t length;          // Bytes stored
+    size_t* lines;          // Offset where each line starts; lines[0] is 0
+    size_t line_count;
+    size_t line_capacity;
+    size_t lone_newlines;   // \n not preceded by \r, each grows to \r\n in WM_GETTEXT
+    size_t longest_line;    // In characters, for the horizontal scroll bar
+    char last_char;
+    size_t top_line;        // First line on screen
+    size_t left_column;     // First column on screen
+    HFONT font;
+    int char_width;
+    int line_height;
+} OutputView;
+
+static void OutputView_clear(OutputView* view) {
+    for (size_t i = 0; i < view->chunk_count; i++)
+        free(view->chunks[i]);
+    view->chunk_count = 0;
+    view->length = 0;
+    view->line_count = 1;
+    view->lone_newlines = 0;
+    view->longest_line = 0;
+    view->last_char = '\0';
+    view->top_line = 0;
+    view->left_column = 0;
+}
+
+static BOOL OutputView_add_line(OutputView* view, size_t start) {
+    if (view->line_count == view->line_capacity) {
+        size_t capacity = view->line_capacity ? view->line_capacity * 2 : 1024;
+        size_t* lines = (size_t*)realloc(view->lines, capacity * sizeof(size_t));
+        if (!lines)
+            return FALSE;
+        view->lines = lines;
+        view->line_capacity = capacity;
+    }
+    view->lines[view->line_count++] = start;
+    return TRUE;
+}
+
+// Stores text and indexes its line breaks. Returns FALSE if memory ran out,
+// in which case only part of the text was added.
+static BOOL OutputView_append(OutputView* view, const char* text, size_t length) {
+    while (length > 0) {
+        size_t used = view->length % OUTPUT_VIEW_CHUNK_SIZE;
+        if (used == 0 && view->length == view->chunk_count * OUTPUT_VIEW_CHUNK_SIZE) {
+            if (view->chunk_count == view->chunk_capacity) {
+                size_t capacity = view->chunk_capacity ? view->chunk_capacity * 2 : 16;
+                char** chunks = (char**)realloc(view->chunks, capacity * sizeof(char*));
+                if (!chunks)
+                    return FALSE;
+                view->chunks = chunks;
+                view->chunk_capacity = capacity;
+            }
+            if (!(view->chunks[view->chunk_count] = (char*)malloc(OUTPUT_VIEW_CHUNK_SIZE)))
+                return FALSE;
+            view->chunk_count++;
+        }
+        size_t count = OUTPUT_VIEW_CHUNK_SIZE - used;
+        if (count > length)
+            count = length;
+        char* dest = view->chunks[view->length / OUTPUT_VIEW_CHUNK_SIZE] + used;
+        memcpy(dest, text, count);
+        for (size_t i = 0; i < count; i++) {
+            if (dest[i] == '\n') {
+                if (view->last_char != '\r')
+                    view->lone_newlines++;
+                size_t line_length = view->length + i - view->lines[view->line_count - 1];
+                if (line_length > view->longest_line)
+                    view->longest_line = line_length;
+                if (!OutputView_add_line(view, view->length + i + 1)) {
+                    view->length += i;
+                    return FALSE;
+                }
+            }
+            view->last_char = dest[i];
+        }
+        view->length += count;
+        text += count;
+        length -= count;
+    }
+    size_t line_length = view->length - view->lines[view->line_count - 1];
+    if (line_length > view->longest_line)
+        view->longest_line = line_length;
+    return TRUE;
+}
+
+// Copies length bytes starting at offset, which must be within the text.
+static void OutputView_copy(const OutputView* view, size_t offset, size_t length, char* dest) {
+    while (length > 0) {
+        size_t used = offset % OUTPUT_VIEW_CHUNK_SIZE;
+        size_t count = OUTPUT_VIEW_CHUNK_SIZE - used;
+        if (count > length)
+            count = length;
+        memcpy(dest, view->chunks[offset / OUTPUT_VIEW_CHUNK_SIZE] + used, count);
+        dest += count;
+        offset += count;
+        length -= count;
+    }
+}
+
+// Text of a line without its line break.
+static void OutputView_line_range(const OutputView* view, size_t line, size_t* start, size_t* length) {
+    size_t end = line + 1 < view->line_count ? view->lines[line + 1] - 1 : view->length;
+    *start = view->lines[line];
+    *length = end - *start;
+}
+
+static int OutputView_visible_lines(HWND hwnd, const OutputView* view) {
+    RECT rc;
+    GetClientRect(hwnd, &rc);
+    int lines = (rc.bottom - rc.top) / view->line_height;
+    return lines > 0 ? lines : 1;
+}
+
+static int OutputView_visible_columns(HWND hwnd, const OutputView* view) {
+    RECT rc;
+    GetClientRect(hwnd, &rc);
+    int columns = (rc.right - rc.left) / view->char_width;
+    return columns > 0 ? columns : 1;
+}
+
+// Scroll positions are ints, which holds more lines than fit in memory on
+// 32-bit Windows.
+static void OutputView_update_scrollbars(HWND hwnd, OutputView* view) {
+    SCROLLINFO si = {0};
+    size_t page = (size_t)OutputView_visible_lines(hwnd, view);
+    size_t columns = (size_t)OutputView_visible_columns(hwnd, view);
+
+    if (view->top_line + page > view->line_count)
+        view->top_line = view->line_count > page ? view->line_count - page : 0;
+    if (view->left_column + columns > view->longest_line)
+        view->left_column = view->longest_line > columns ? view->longest_line - columns : 0;
+
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin = 0;
+    si.nMax = (int)view->line_count - 1;
+    si.nPage = (UINT)page;
+    si.nPos = (int)view->top_line;
+    SetScrollInfo(hwnd, SB_VERT, &si, TRUE);
+
+    si.nMax = view->longest_line ? (int)view->longest_line - 1 : 0;
+    si.nPage = (UINT)columns;
+    si.nPos = (int)view->left_column;
+    SetScrollInfo(hwnd, SB_HORZ, &si, TRUE);
+}
+
+static void OutputView_scroll_to(HWND hwnd, OutputView* view, long long line, long long column) {
+    long long last_line = (long long)view->line_count - OutputView_visible_lines(hwnd, view);
+    long long last_column = (long long)view->longest_line - OutputView_visible_columns(hwnd, view);
+    if (line > last_line)
+        line = last_line;
+    if (line < 0)
+        line = 0;
+    if (column > last_column)
+        column = last_column;
+    if (column < 0)
+        column = 0;
+    if ((size_t)line != view->top_line || (size_t)column != view->left_column) {
+        view->top_line = (size_t)line;
+        view->left_column = (size_t)column;
+        OutputView_update_scrollbars(hwnd, view);
+        InvalidateRect(hwnd, NULL, TRUE);
+    }
+}
+
+static void OutputView_measure_font(HWND hwnd, OutputView* view) {
+    HDC hdc = GetDC(hwnd);
+    HFONT hOldFont = NULL;
+    TEXTMETRIC tm;
+    if (view->font)
+        hOldFont = (HFONT)SelectObject(hdc, view->font);
+    GetTextMetrics(hdc, &tm);
+    view->char_width = tm.tmAveCharWidth > 0 ? tm.tmAveCharWidth : 8;
+    view->line_height = tm.tmHeight + tm.tmExternalLeading > 0 ? tm.tmHeight + tm.tmExternalLeading : 16;
+    if (hOldFont)
+        SelectObject(hdc, hOldFont);
+    ReleaseDC(hwnd, hdc);
+}
+
+static void OutputView_paint(HWND hwnd, OutputView* view) {
+    PAINTSTRUCT ps;
+    HDC hdc = BeginPaint(hwnd, &ps);
+    HFONT hOldFont = NULL;
+    char line_text[OUTPUT_VIEW_MAX_COLUMNS];
+    size_t columns = (size_t)OutputView_visible_columns(hwnd, view) + 1;
+    size_t first = view->top_line + (size_t)(ps.rcPaint.top / view->line_height);
+    size_t last = view->top_line + (size_t)(ps.rcPaint.bottom / view->line_height) + 1;
+
+    if (columns > OUTPUT_VIEW_MAX_COLUMNS)
+        columns = OUTPUT_VIEW_MAX_COLUMNS;
+    if (last > view->line_count)
+        last = view->line_count;
+    if (view->font)
+        hOldFont = (HFONT)SelectObject(hdc, view->font);
+    SetTextColor(hdc, GetSysColor(COLOR_WINDOWTEXT));
+    SetBkColor(hdc, GetSysColor(COLOR_WINDOW));
+
+    for (size_t line = first; line < last; line++) {
+        size_t start, length;
+        OutputView_line_range(view, line, &start, &length);
+        if (length > 0 && line + 1 < view->line_count) {
+            char last_char;
+            OutputView_copy(view, start + length - 1, 1, &last_char);
+            if (last_char == '\r')
+                length--;
+        }
+        if (length <= view->left_column)
+            continue;
+        length -= view->left_column;
+        if (length > columns)
+            length = columns;
+        OutputView_copy(view, start + view->left_column, length, line_text);
+        for (size_t i = 0; i < length; i++) {
+            if ((unsigned char)line_text[i] < ' ')
+                line_text[i] = ' ';
+        }
+        TextOutA(hdc, 0, (int)(line - view->top_line) * view->line_height, line_text, (int)length);
+    }
+
+    if (hOldFont)
+        SelectObject(hdc, hOldFont);
+    EndPaint(hwnd, &ps);
+}
+
+static int OutputView_scroll_position(HWND hwnd, int bar, int request, int line, int page) {
+    SCROLLINFO si = {0};
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_ALL;
+    GetScrollInfo(hwnd, bar, &si);
+    switch (request) {
+        case SB_TOP: return si.nMin;
+        case SB_BOTTOM: return si.nMax;
+        case SB_LINEUP: return si.nPos - line;
+        case SB_LINEDOWN: return si.nPos + line;
+        case SB_PAGEUP: return si.nPos - page;
+        case SB_PAGEDOWN: return si.nPos + page;
+        case SB_THUMBTRACK:
+        case SB_THUMBPOSITION: return si.nTrackPos;
+    }
+    return si.nPos;
+}
+
+LRESULT CALLBACK OutputViewProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    OutputView* view = (OutputView*)GetWindowLongPtrA(hwnd, GWLP_USERDATA);
+
+    switch (uMsg) {
+        case WM_NCCREATE:
+            view = (OutputView*)calloc(1, sizeof(OutputView));
+            if (!view || !OutputView_add_line(view, 0)) {
+                free(view);
+                return FALSE;
+            }
+            SetWindowLongPtrA(hwnd, GWLP_USERDATA, (LONG_PTR)view);
+            OutputView_measure_font(hwnd, view);
+            break;
+        case WM_NCDESTROY:
+            if (view) {
+                OutputView_clear(view);
+                free(view->chunks);
+                free(view->lines);
+                free(view);
+                SetWindowLongPtrA(hwnd, GWLP_USERDATA, 0);
+            }
+            break;
+        case WM_SETFONT:
+            view->font = (HFONT)wParam;
+            OutputView_measure_font(hwnd, view);
+            OutputView_update_scrollbars(hwnd, view);
+            if (LOWORD(lParam))
+                InvalidateRect(hwnd, NULL, TRUE);
+            return 0;
+        case WM_GETFONT:
+            return (LRESULT)view->font;
+        case WM_SIZE:
+            OutputView_update_scrollbars(hwnd, view);
+            InvalidateRect(hwnd, NULL, TRUE);
+            return 0;
+        case WM_ERASEBKGND:
+        {
+            RECT rc;
+            GetClientRect(hwnd, &rc);
+            FillRect((HDC)wParam, &rc, GetSysColorBrush(COLOR_WINDOW));
+            return 1;
+        }
+        case WM_PAINT:
+            OutputView_paint(hwnd, view);
+            return 0;
+        case WM_VSCROLL:
+            OutputView_scroll_to(hwnd, view, OutputView_scroll_position(hwnd, SB_VERT, LOWORD(wParam), 1, OutputView_visible_lines(hwnd, view)), (long long)view->left_column);
+            return 0;
+        case WM_HSCROLL:
+            OutputView_scroll_to(hwnd, view, (long long)view->top_line, OutputView_scroll_position(hwnd, SB_HORZ, LOWORD(wParam), 1, OutputView_visible_columns(hwnd, view)));
+            return 0;
+        case WM_MOUSEWHEEL:
+            OutputView_scroll_to(hwnd, view, (long long)view->top_line - (short)HIWORD(wParam) / WHEEL_DELTA * OUTPUT_VIEW_WHEEL_LINES, (long long)view->left_column);
+            return 0;
+        case WM_KEYDOWN:
+        {
+            long long page = OutputView_visible_lines(hwnd, view);
+            long long line = (long long)view->top_line, column = (long long)view->left_column;
+            BOOL control = GetKeyState(VK_CONTROL) < 0;
+            switch (wParam) {
+                case VK_UP: line--; break;
+                case VK_DOWN: line++; break;
+                case VK_PRIOR: line -= page; break;
+                case VK_NEXT: line += page; break;
+                case VK_LEFT: column--; break;
+                case VK_RIGHT: column++; break;
+                case VK_HOME:
+                    column = 0;
+                    if (control)
+                        line = 0;
+                    break;
+                case VK_END:
+                    if (control)
+                        line = (long long)view->line_count;
+                    break;
+                default: return DefWindowProc(hwnd, uMsg, wParam, lParam);
+            }
+            OutputView_scroll_to(hwnd, view, line, column);
+            return 0;
+        }
+        case WM_LBUTTONDOWN:
+            SetFocus(hwnd);
+            return 0;
+        case WM_GETDLGCODE:
+            return DLGC_WANTARROWS;
+        case WM_SETTEXT:
+            OutputView_clear(view);
+            if (lParam)
+                OutputView_append(view, (const char*)lParam, strlen((const char*)lParam));
+            OutputView_update_scrollbars(hwnd, view);
+            InvalidateRect(hwnd, NULL, TRUE);
+            return TRUE;
+        case WM_GETTEXTLENGTH:
+            return (LRESULT)(view->length + view->lone_newlines);
+        case WM_GETTEXT:
+        {
+            // Expands lone \n to \r\n and stops early rather than split one.
+            char* dest = (char*)lParam;
+            size_t space = (size_t)wParam, written = 0;
+            char previous = '\0';
+            if (space == 0)
+                return 0;
+            for (size_t offset = 0; offset < view->length && written + 1 < space; offset++) {
+                char c = view->chunks[offset / OUTPUT_VIEW_CHUNK_SIZE][offset % OUTPUT_VIEW_CHUNK_SIZE];
+                if (c == '\n' && previous != '\r') {
+                    if (written + 2 >= space)
+                        break;
+                    dest[written++] = '\r';
+                }
+                dest[written++] = c;
+                previous = c;
+            }
+            dest[written] = '\0';
+            return (LRESULT)written;
+        }
+        case OVM_APPEND:
+        {
+            // Follows the end of the text if it was already in view.
+            size_t page = (size_t)OutputView_visible_lines(hwnd, view);
+            BOOL following = view->top_line + page >= view->line_count;
+            size_t old_lines = view->line_count;
+            BOOL appended = OutputView_append(view, (const char*)lParam, (size_t)wParam);
+            if (following && view->line_count > page)
+                view->top_line = view->line_count - page;
+            OutputView_update_scrollbars(hwnd, view);
+            if (following || old_lines - 1 < view->top_line + page)
+                InvalidateRect(hwnd, NULL, TRUE);
+            return appended;
+        }
+    }
+    return DefWindowProc(hwnd, uMsg, wParam, lParam);
+}
+
+BOOL RegisterOutputViewClass(HINSTANCE hInstance) {
+    WNDCLASSA wc = {0};
+    wc.lpfnWndProc = OutputViewProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = OUTPUT_VIEW_CLASS;
+    wc.hCursor = LoadCursor(NULL, IDC_ARROW);
+    wc.hbrBackground = NULL; // WM_ERASEBKGND paints it
+    return RegisterClassA(&wc) != 0;
+}